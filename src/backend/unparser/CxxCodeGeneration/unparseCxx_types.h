@@ -26,7 +26,8 @@ class Unparse_Type
           Unparse_Type(Unparser* unp);
           virtual ~Unparse_Type();
 
-          void curprint (std::string str);
+          void curprint (const std::string & str);
+          void curprint (const char* str);
           virtual void unparseType(SgType* type, SgUnparse_Info& info);
 
       //! unparse type functions implemented in unparse_type.C
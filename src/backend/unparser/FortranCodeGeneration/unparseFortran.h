@@ -418,7 +418,6 @@ class FortranCodeGeneration_locatedNode : public UnparseLanguageIndependentConst
        // support for Rice Coarray Fortran 2.0
           void unparseWithTeamStatement(SgStatement* stmt, SgUnparse_Info& info); 
           void unparseCoArrayExpression      (SgExpression* expr, SgUnparse_Info& info);
-          void curprint(const std::string&) const;
 
        // Liao 10/20/2010 common unparsing support for OpenMP AST 
           virtual void unparseOmpPrefix          (SgUnparse_Info& info);
@@ -13,6 +13,7 @@ class UnparseFortran_type
           virtual ~UnparseFortran_type() {};
 
           void curprint (const std::string & str) const;
+          void curprint (const char* str) const;
 
           /**
            * @param printAttrs - true means print the type attributes such as dimension or length on the left of ::
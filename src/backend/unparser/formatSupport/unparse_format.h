@@ -85,7 +85,8 @@ class UnparseFormat
 
      public:
 
-          UnparseFormat& operator << (std::string out);
+          UnparseFormat& operator << (const std::string & out);
+          UnparseFormat& operator << (const char* out);
           UnparseFormat& operator << (int num);
           UnparseFormat& operator << (short num);
           UnparseFormat& operator << (unsigned short num);
@@ -101,6 +102,9 @@ class UnparseFormat
        // DQ (10/13/2006): Added to support debugging!
        // UnparseFormat& operator << (void* pointerValue);
 
+      //! output the first length characters of text (the text does not need to be null terminated)
+          UnparseFormat& write (const char* text, size_t length);
+
           int current_line() const { return currentLine; }
           int current_col() const { return chars_on_line; }
           bool line_is_empty() const { return currentIndent == chars_on_line; }
@@ -30,7 +30,9 @@ class Unparse_MOD_SAGE
 
           void cur_set_linewrap (int nr);
 
-          void curprint(std::string str);
+          void curprint(const std::string & str);
+          void curprint(const char* str);
+          void curprint(const char* str, size_t length);
           void curprint_newline();
 
       //! functions that test for overloaded operator function (modified_sage.C)
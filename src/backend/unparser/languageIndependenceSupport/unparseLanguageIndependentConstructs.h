@@ -134,6 +134,8 @@ class UnparseLanguageIndependentConstructs
              }
 #endif
           void curprint (const std::string & str) const;
+          void curprint (const char* str) const;
+          void curprint (const char* str, size_t length) const;
           void printOutComments ( SgLocatedNode* locatedNode ) const;
 
       //! Unparser support for compiler-generated statments
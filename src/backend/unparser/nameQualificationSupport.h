@@ -24,6 +24,20 @@
 // API function for new hidden list support.
 void generateNameQualificationSupport( SgNode* node, std::set<SgNode*> & referencedNameSet );
 
+// Incremental version of the name qualification support (used with -rose:incremental_name_qualification).  The first call
+// for a file does the full traversal and records, for each declaration in the global scope, which map entries it touched
+// and which declarations it added to the referencedNameSet.  Later calls recompute only the declarations whose subtree
+// changed (and those sharing map entries with them); any change to a global, namespace or class scope (not local to a
+// function) forces the full traversal.  IR nodes are recognized by their address and by the number of IR nodes of their
+// type deleted so far (SgNode::numberOfDeletedNodes), so that a new IR node allocated where a deleted one was is seen as a
+// change; deleting IR nodes of a type therefore recomputes every declaration that refers to IR nodes of that type.  If
+// validate is true the result is compared with a full recomputation.
+void generateIncrementalNameQualificationSupport( SgSourceFile* file, std::set<SgNode*> & referencedNameSet, bool validate );
+
+// Discards the dependence record kept for the file (the next call recomputes everything).  The record is an attribute
+// of the file, so it is also deleted with the file.
+void clearIncrementalNameQualificationSupport( SgSourceFile* file );
+
 class NameQualificationInheritedAttribute
    {
      private:
@@ -42,6 +56,100 @@ class NameQualificationInheritedAttribute
    };
 
 
+// Dependence record for the incremental name qualification, kept as an attribute of the file (so that it is deleted
+// with the file and is not copied with it).  Entry 0 is for the IR nodes traversed outside of any declaration of the
+// global scope, entry i > 0 for the i-th declaration.
+class NameQualificationRecord : public AstAttribute
+   {
+     public:
+       // Name of the attribute of the SgSourceFile.
+          static const char* attributeName;
+
+          struct StatementEntry
+             {
+               SgDeclarationStatement* statement;
+               uint64_t fingerprint;
+
+            // Keys looked up or written in the qualified name maps while traversing this statement.
+               std::vector<SgNode*> touchedKeys;
+
+            // Declarations this statement added to the referencedNameSet (in order).
+               std::vector<SgNode*> referencedNames;
+
+            // Inherited attribute the traversal passed to the statement (its traversal is restarted from it).
+               NameQualificationInheritedAttribute inheritedAttribute;
+
+               StatementEntry(SgDeclarationStatement* input_statement) : statement(input_statement), fingerprint(0) {}
+             };
+
+          SgGlobal* globalScope;
+          std::vector<StatementEntry> statements;
+          rose_hash::unordered_map<SgNode*,size_t> statementIndex;
+
+       // Signatures of the scopes that can be seen from more than one declaration of the global scope.
+          std::map<SgScopeStatement*,uint64_t> scopeSignatures;
+
+       // For each key touched, the statements that touched it.
+          rose_hash::unordered_map<SgNode*,std::vector<size_t> > keyOwners;
+
+          size_t currentStatement;
+
+       // Builds the statement list and computes the fingerprints and scope signatures of the file.
+          NameQualificationRecord(SgSourceFile* file);
+
+          void touch(SgNode* key) { statements[currentStatement].touchedKeys.push_back(key); }
+          void reference(SgNode* declaration) { statements[currentStatement].referencedNames.push_back(declaration); }
+
+       // Switches the current statement as the traversal enters (or leaves) the declarations of the global scope.
+       // Returns true if the node is one of these declarations.
+          bool enterNode(SgNode* node);
+          void leaveNode(SgNode* node);
+
+       // Same statements and unchanged scope signatures.
+          bool hasSameScopes(const NameQualificationRecord & X) const;
+
+          void buildKeyIndex();
+
+       // All the keys of the record: those of the key index and those touched since it was built.
+          std::set<SgNode*> allKeys() const;
+
+          virtual OwnershipPolicy getOwnershipPolicy() const ROSE_OVERRIDE { return CONTAINER_OWNERSHIP; }
+          virtual std::string attribute_class_name() const ROSE_OVERRIDE { return "NameQualificationRecord"; }
+   };
+
+// Reference to one of the qualified name maps that reports the keys used to the NameQualificationRecord (if any).
+// Only the part of the map interface used by the NameQualificationTraversal is provided.
+class NameQualificationMap
+   {
+     private:
+          rose_node_string_hash_map & map;
+
+     public:
+          typedef rose_node_string_hash_map::iterator iterator;
+
+          NameQualificationRecord* record;
+
+          NameQualificationMap(rose_node_string_hash_map & input_map) : map(input_map), record(NULL) {}
+
+          iterator find(SgNode* key)
+             {
+               if (record != NULL)
+                    record->touch(key);
+               return map.find(key);
+             }
+
+          iterator end() { return map.end(); }
+
+          std::pair<iterator,bool> insert(const rose_node_string_hash_map::value_type & x)
+             {
+               if (record != NULL)
+                    record->touch(x.first);
+               return map.insert(x);
+             }
+
+          operator rose_node_string_hash_map & () const { return map; }
+   };
+
 class NameQualificationSynthesizedAttribute
    {
      public:
@@ -72,15 +180,19 @@ class NameQualificationTraversal : public AstTopDownBottomUpProcessing<NameQuali
        // to the static data members in SgNode, but this does not permit the proper handling of nexted types in 
        // templates since the unparser uses the SgNode static members directly.  so the switch to make this a 
        // reference fixes this problem.
-          std::map<SgNode*,std::string> & qualifiedNameMapForNames;
-          std::map<SgNode*,std::string> & qualifiedNameMapForTypes;
+       // The NameQualificationMap wrappers report the keys used to the record of the incremental name qualification.
+          NameQualificationMap qualifiedNameMapForNames;
+          NameQualificationMap qualifiedNameMapForTypes;
 
        // DQ (9/7/2014): Modified to handle template header map (for template declarations).
-          std::map<SgNode*,std::string> & qualifiedNameMapForTemplateHeaders;
+          NameQualificationMap qualifiedNameMapForTemplateHeaders;
 
        // DQ (6/3/2011): This is to save the names of types where they can be named differently when referenced 
        // from different locations in the source code.
-          std::map<SgNode*,std::string> & typeNameMap;
+          NameQualificationMap typeNameMap;
+
+       // Dependence record of the incremental name qualification (NULL if not recording).
+          NameQualificationRecord* record;
 
        // DQ (7/22/2011): Alternatively we should treat array types just like templated types that can
        // contain subtypes that require arbitrarily complex name qualification for their different parts.
@@ -115,10 +227,10 @@ class NameQualificationTraversal : public AstTopDownBottomUpProcessing<NameQuali
        // HiddenListTraversal(SgNode* root);
 
        // DQ (9/7/2014): Modified to handle template header map (for template declarations).
-          NameQualificationTraversal(std::map<SgNode*,std::string> & input_qualifiedNameMapForNames, 
-                                     std::map<SgNode*,std::string> & input_qualifiedNameMapForTypes, 
-                                     std::map<SgNode*,std::string> & input_qualifiedNameMapForTemplateHeaders, 
-                                     std::map<SgNode*,std::string> & input_typeNameMap, 
+          NameQualificationTraversal(rose_node_string_hash_map & input_qualifiedNameMapForNames, 
+                                     rose_node_string_hash_map & input_qualifiedNameMapForTypes, 
+                                     rose_node_string_hash_map & input_qualifiedNameMapForTemplateHeaders, 
+                                     rose_node_string_hash_map & input_typeNameMap, 
                                      std::set<SgNode*> & input_referencedNameSet);
 
        // DQ (7/23/2011): This permits recursive calls to the traversal AND specification of the current scope
@@ -126,6 +238,12 @@ class NameQualificationTraversal : public AstTopDownBottomUpProcessing<NameQuali
        // for name qualification of const expressions in SgArrayType index expressions.
           void generateNestedTraversalWithExplicitScope( SgNode* node, SgScopeStatement* currentScope );
 
+       // Records the dependences of the computed names into the record (see generateIncrementalNameQualificationSupport()).
+          void set_record(NameQualificationRecord* input_record);
+
+       // Adds the declaration to the referencedNameSet (and to the record).
+          void addToReferencedNameSet(SgNode* declaration);
+
        // Evaluates how much name qualification is required (typically 0 (no qualification), but sometimes 
        // the depth of the nesting of scopes plus 1 (full qualification with global scoping operator)).
        // int nameQualificationDepth ( SgClassDefinition* classDefinition );
@@ -214,9 +332,9 @@ class NameQualificationTraversal : public AstTopDownBottomUpProcessing<NameQuali
           void evaluateNameQualificationForTemplateArgumentList ( SgTemplateArgumentPtrList & templateArgumentList, SgScopeStatement* currentScope, SgStatement* positionStatement );
 
        // DQ (5/28/2011): Added support to set the global qualified name map.
-          const std::map<SgNode*,std::string> & get_qualifiedNameMapForNames() const;
-          const std::map<SgNode*,std::string> & get_qualifiedNameMapForTypes() const;
-          const std::map<SgNode*,std::string> & get_qualifiedNameMapForTemplateHeaders() const;
+          const rose_node_string_hash_map & get_qualifiedNameMapForNames() const;
+          const rose_node_string_hash_map & get_qualifiedNameMapForTypes() const;
+          const rose_node_string_hash_map & get_qualifiedNameMapForTemplateHeaders() const;
 
        // DQ (6/3/2011): Evaluate types to permit the strings representing unparsing the types 
        // are saved in a separate map associated with the IR node referencing the type.  This 
@@ -120,6 +120,70 @@ public:
     virtual SgAsmInstruction *make_unknown_instruction(const Exception&) ROSE_OVERRIDE;
 
 
+    /*========================================================================================================================
+     * Fast decoding.
+     *========================================================================================================================*/
+public:
+
+    /** Lightweight description of a decoded instruction.
+     *
+     *  This is a plain-old-data type filled in by @ref decodeFast without allocating any IR nodes. It holds only the
+     *  information needed to step through memory one instruction at a time and to follow control flow: the instruction
+     *  size, how it affects control flow, and the target of direct branches and calls.  The raw bytes are saved so that
+     *  the instruction can be converted to a full @ref SgAsmX86Instruction later by calling @ref promote. */
+    struct DecodedInstruction {
+        /** How an instruction affects control flow. */
+        enum Flow {
+            FLOW_INVALID,                               /**< Bytes are not a valid instruction. */
+            FLOW_FALLTHROUGH,                           /**< Always continues with the following instruction. */
+            FLOW_BRANCH,                                /**< Unconditional jump to @c target, or to an unknown address. */
+            FLOW_CONDITIONAL,                           /**< Either jumps to @c target or continues with the following insn. */
+            FLOW_CALL,                                  /**< Function call to @c target, or to an unknown address. */
+            FLOW_RETURN,                                /**< Return from function or interrupt; successor known at run time. */
+            FLOW_TRAP,                                  /**< Int3, into, ud2, etc.; successor is not known statically. */
+            FLOW_HALT                                   /**< Instruction has no successors. */
+        };
+
+        rose_addr_t va;                                 /**< Starting address of the instruction. */
+        rose_addr_t target;                             /**< Branch or call target when @c hasTarget is set. */
+        X86InstructionKind kind;                        /**< Kind for control transfers, otherwise x86_unknown_instruction. */
+        Flow flow;                                      /**< Effect on control flow. */
+        bool hasTarget;                                 /**< Whether @c target is known. */
+        uint8_t size;                                   /**< Size of the instruction in bytes, or zero if invalid. */
+        uint8_t nRawBytes;                              /**< Number of bytes saved in @c rawBytes. */
+        uint8_t rawBytes[15];                           /**< Bytes of the instruction (or available bytes if invalid). */
+
+        /** Whether the bytes were decoded as an instruction. */
+        bool isValid() const { return flow != FLOW_INVALID; }
+
+        /** Address of the following instruction. */
+        rose_addr_t fallThroughVa() const { return va + size; }
+    };
+
+    /** Decode an instruction without building an AST.
+     *
+     *  Decodes the instruction at the start of @p buf, which is assumed to be located at virtual address @p va, using
+     *  precomputed opcode tables. Fills in @p decoded and returns true if the bytes form a valid instruction.  This is much
+     *  faster than @ref disassembleOne because it doesn't allocate anything, and it doesn't modify the disassembler, so it
+     *  may be called concurrently from multiple threads.
+     *
+     *  The fast decoder identifies instructions only to the extent necessary to determine their size and effect on control
+     *  flow.  Whenever @ref disassembleOne accepts an instruction, the fast decoder returns the same size and control flow,
+     *  but the fast decoder may accept some prefix and opcode combinations that the full disassembler rejects. Use @ref
+     *  promote to obtain the full instruction when its details are needed.
+     *
+     * @{ */
+    bool decodeFast(rose_addr_t va, const uint8_t *buf, size_t bufsz, DecodedInstruction &decoded /*out*/) const;
+    bool decodeFast(const MemoryMap::Ptr &map, rose_addr_t va, DecodedInstruction &decoded /*out*/) const;
+    /** @} */
+
+    /** Convert a fast-decoded instruction to a full instruction.
+     *
+     *  Disassembles the bytes saved in @p decoded, building the same @ref SgAsmX86Instruction that @ref disassembleOne would
+     *  return for those bytes.  Throws a @ref Disassembler::Exception if the bytes are not a valid instruction. */
+    SgAsmX86Instruction *promote(const DecodedInstruction &decoded);
+
+
     /*========================================================================================================================
      * Data types
      *========================================================================================================================*/
@@ -297,6 +297,8 @@ struct PartitionerSettings {
     bool findingThunks;                             /**< Look for common thunk patterns in undiscovered areas. */
     bool splittingThunks;                           /**< Split thunks into their own separate functions. */
     SemanticMemoryParadigm semanticMemoryParadigm;  /**< Container used for semantic memory states. */
+    bool speculativeDecoding;                       /**< Decode instructions for pending basic blocks in worker threads. */
+    bool bulkPrologueScan;                          /**< Find function prologue candidates in one parallel memory scan. */
     bool namingConstants;                           /**< Give names to constants by calling @ref Modules::nameConstants. */
     bool namingStrings;                             /**< Give labels to constants that are string literal addresses. */
     bool demangleNames;                             /**< Run all names through a demangling step. */
@@ -339,7 +341,8 @@ public:
           findingInterFunctionCalls(true), doingPostAnalysis(true), doingPostFunctionMayReturn(true),
           doingPostFunctionStackDelta(true), doingPostCallingConvention(false), doingPostFunctionNoop(false),
           functionReturnAnalysis(MAYRETURN_DEFAULT_YES), findingDataFunctionPointers(false), findingCodeFunctionPointers(false),
-          findingThunks(true), splittingThunks(false), semanticMemoryParadigm(LIST_BASED_MEMORY), namingConstants(true),
+          findingThunks(true), splittingThunks(false), semanticMemoryParadigm(LIST_BASED_MEMORY), speculativeDecoding(false),
+          bulkPrologueScan(false), namingConstants(true),
           namingStrings(true), demangleNames(true) {}
 };
 
@@ -350,6 +353,7 @@ public:
 struct EngineSettings {
     std::vector<std::string> configurationNames;    /**< List of configuration files and/or directories. */
     bool exitOnError;                               /**< If true, emit error message and exit non-zero, else throw. */
+    std::string snapshotName;                       /**< Partitioner snapshot file to load if it exists, else create. */
 
     EngineSettings()
         : exitOnError(true) {}
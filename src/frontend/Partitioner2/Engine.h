@@ -9,6 +9,11 @@
 #include <Partitioner2/Utility.h>
 #include <Sawyer/DistinctList.h>
 
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
 namespace rose {
 namespace BinaryAnalysis {
 namespace Partitioner2 {
@@ -131,6 +136,29 @@ private:
         virtual bool operator()(bool chain, const Args &args) ROSE_OVERRIDE;
     };
     
+    // Decodes instructions in worker threads so they're already cached in the instruction provider by the time the
+    // partitioner discovers the basic blocks that contain them.  Each worker has its own disassembler and decodes forward
+    // from a queued address until it reaches an instruction that terminates a basic block or an address that's already
+    // cached. Only the instruction cache is affected, so the partitioning results are the same as without speculation.
+    // Decoding allocates IR nodes, and the instruction provider serializes it with the main thread's decoding, so a worker
+    // overlaps decoding with the main thread's analysis of the blocks already decoded rather than decoding in parallel with
+    // other workers. Workers never delete IR nodes.
+    class SpeculativeDecoder: boost::noncopyable {
+        const InstructionProvider &insns_;
+        boost::mutex mutex_;                                               // protects the following data members
+        boost::condition_variable workInserted_;                           // signaled when work is added or we're stopping
+        std::vector<rose_addr_t> work_;                                    // addresses to decode (last-in-first-out)
+        bool stopping_;                                                    // set when workers should exit
+        std::vector<Disassembler*> disassemblers_;                         // one per worker
+        boost::thread_group workers_;
+    public:
+        SpeculativeDecoder(const InstructionProvider&, size_t nWorkers);
+        ~SpeculativeDecoder();
+        void insert(rose_addr_t va);
+    private:
+        void work(Disassembler*);
+    };
+
     // Basic blocks that need to be worked on next. These lists are adjusted whenever a new basic block (or placeholder) is
     // inserted or erased from the CFG.
     class BasicBlockWorkList: public CfgAdjustmentCallback {
@@ -139,8 +167,9 @@ private:
         Sawyer::Container::DistinctList<rose_addr_t> finalCallReturn_;     // indeterminate call sites awaiting final analysis
         Sawyer::Container::DistinctList<rose_addr_t> undiscovered_;        // undiscovered basic block list (last-in-first-out)
         Engine *engine_;                                                   // engine to which this callback belongs
+        SpeculativeDecoder *decoder_;                                      // optional decoder for undiscovered blocks
     protected:
-        explicit BasicBlockWorkList(Engine *engine): engine_(engine) {}
+        explicit BasicBlockWorkList(Engine *engine): engine_(engine), decoder_(NULL) {}
     public:
         typedef Sawyer::SharedPointer<BasicBlockWorkList> Ptr;
         static Ptr instance(Engine *engine) { return Ptr(new BasicBlockWorkList(engine)); }
@@ -150,6 +179,7 @@ private:
         Sawyer::Container::DistinctList<rose_addr_t>& processedCallReturn() { return processedCallReturn_; }
         Sawyer::Container::DistinctList<rose_addr_t>& finalCallReturn() { return finalCallReturn_; }
         Sawyer::Container::DistinctList<rose_addr_t>& undiscovered() { return undiscovered_; }
+        void decoder(SpeculativeDecoder *d) { decoder_ = d; }
         void moveAndSortCallReturn(const Partitioner&);
     };
 
@@ -350,6 +380,11 @@ public:
      *
      *  Returns the partitioner that was used and which contains the results.
      *
+     *  If the @ref snapshotName property is set and names an existing file, then the partitioner is restored from that file
+     *  by @ref loadPartitioner instead, and the specimens are not loaded.  If it's set but the file doesn't exist, then the
+     *  results of partitioning are saved to that file by @ref savePartitioner.  A snapshot that was saved for other specimen
+     *  files or other partitioning settings is rejected with an error rather than restored.
+     *
      *  If an <code>std::runtime_exception</code> occurs and the @ref exitOnError property is set, then the exception is caught,
      *  its text is emitted to the partitioner's fatal error stream, and <code>exit(1)</code> is invoked.
      *
@@ -358,6 +393,38 @@ public:
     Partitioner partition(const std::string &fileName) /*final*/;
     /** @} */
 
+    /** Save a partitioner to a snapshot file.
+     *
+     *  Writes the complete state of the partitioner, including its CFG, functions, data blocks, address usage map, memory map,
+     *  and instruction cache, to the specified file so that it can be restored later by @ref loadPartitioner without
+     *  disassembling and partitioning the specimen again.  The file starts with a short text header that identifies the
+     *  snapshot format version, the ROSE version, and the @ref specimenDigest of the specified specimen names, followed by a
+     *  binary archive.  The file is written under a temporary name and then renamed, so an interrupted save never leaves a
+     *  truncated snapshot.
+     *
+     *  Throws an <code>std::runtime_error</code> if ROSE was configured without the boost serialization library or the file
+     *  cannot be written. */
+    virtual void savePartitioner(const Partitioner&, const boost::filesystem::path&,
+                                 const std::vector<std::string> &specimen = std::vector<std::string>());
+
+    /** Load a partitioner from a snapshot file.
+     *
+     *  Restores a partitioner that was saved by @ref savePartitioner.  The file is memory mapped and deserialized directly
+     *  from the mapping.  Throws an <code>std::runtime_error</code> if the file is not a snapshot, if it was written by a
+     *  different snapshot format version or ROSE version, or if ROSE was configured without the boost serialization library.
+     *  If specimen names are specified, then the error is also thrown if the snapshot's specimen digest differs from the @ref
+     *  specimenDigest of those names, which means the snapshot was saved for different specimen files or settings. */
+    virtual Partitioner loadPartitioner(const boost::filesystem::path&,
+                                        const std::vector<std::string> &specimen = std::vector<std::string>());
+
+    /** Digest that identifies a specimen for partitioner snapshots.
+     *
+     *  The digest covers the specimen names, the contents of the files they name, and the engine settings that affect the
+     *  partitioning results (loader, disassembler, and partitioner settings, and the configuration names). The contents of
+     *  configuration files and of process memory are not included.  Throws an <code>std::runtime_error</code> if ROSE was
+     *  configured without the boost serialization library. */
+    virtual std::string specimenDigest(const std::vector<std::string> &specimen);
+
     /** Obtain an abstract syntax tree.
      *
      *  Constructs a new abstract syntax tree (AST) from partitioner information with these steps:
@@ -683,7 +750,10 @@ public:
      *  Processes the "undiscovered" work list until the list becomes empty.  This list is the list of basic block placeholders
      *  for which no attempt has been made to discover instructions.  This method implements a recursive descent disassembler,
      *  although it does not process the control flow edges in any particular order. Subclasses are expected to override this
-     *  to implement a more directed approach to discovering basic blocks. */
+     *  to implement a more directed approach to discovering basic blocks.
+     *
+     *  If the @ref speculativeDecoding property is set then a worker thread decodes instructions for pending basic blocks
+     *  while this thread discovers and attaches blocks in the usual order. */
     virtual void discoverBasicBlocks(Partitioner&);
 
     /** Scan read-only data to find function pointers.
@@ -732,6 +802,27 @@ public:
      *  vector. */
     virtual std::vector<Function::Ptr> makeNextPrologueFunction(Partitioner&, rose_addr_t startVa);
 
+    /** Find function prologue candidates in bulk.
+     *
+     *  Sweeps every executable segment of the memory map looking for the byte signatures published by the partitioner's
+     *  function prologue matchers (see @ref FunctionPrologueMatcher::signatures).  The segments are divided into chunks that
+     *  are scanned in parallel by the number of threads specified with the "--threads" command-line switch.  A signature that
+     *  occurs inside a run of aligned words that all point into executable memory is ignored since such runs are most likely
+     *  jump tables or other tables of code addresses.
+     *
+     *  Returns the candidate addresses sorted and without duplicates. The matchers are not invoked; see @ref
+     *  makePrologueFunctions. */
+    virtual std::vector<rose_addr_t> scanPrologueCandidates(const Partitioner&);
+
+    /** Make functions at function prologue candidates.
+     *
+     *  Invokes the partitioner's function prologue matchers at each candidate address that is not yet represented in the
+     *  CFG/AUM (see @ref Partitioner::matchFunctionPrologue) and attaches the resulting functions to the partitioner.  All
+     *  candidates are matched before any of the new functions' basic blocks are discovered.
+     *
+     *  Returns the attached functions, some of which may have existed prior to this call. */
+    virtual std::vector<Function::Ptr> makePrologueFunctions(Partitioner&, const std::vector<rose_addr_t> &candidates);
+
     /** Make functions from inter-function calls.
      *
      *  This method scans the unused executable areas between existing functions to look for additional function calls and
@@ -1020,6 +1111,16 @@ public:
     std::vector<rose_addr_t>& startingVas() /*final*/ { return settings_.partitioner.startingVas; }
     /** @} */
 
+    /** Property: Name of partitioner snapshot file.
+     *
+     *  If non-empty, then @ref partition restores the partitioner from this file if it exists, or saves the partitioning
+     *  results to this file if it doesn't exist.
+     *
+     * @{ */
+    const std::string& snapshotName() const /*final*/ { return settings_.engine.snapshotName; }
+    virtual void snapshotName(const std::string &s) { settings_.engine.snapshotName = s; }
+    /** @} */
+
     /** Property: Whether to use instruction semantics.
      *
      *  If set, then instruction semantics are used to fine tune certain analyses that happen during partitioning, such as
@@ -1030,6 +1131,32 @@ public:
     virtual void usingSemantics(bool b) { settings_.partitioner.base.usingSemantics = b; }
     /** @} */
 
+    /** Property: Whether to decode instructions speculatively in parallel.
+     *
+     *  If set, then while basic blocks are being discovered, a worker thread decodes the instructions at the starting
+     *  addresses of pending basic blocks and caches them in the partitioner's instruction provider.  The basic blocks are
+     *  still discovered, evaluated, and attached to the CFG one at a time in the usual order, so the results are the same as
+     *  when this property is clear.  Since decoding allocates IR nodes it is done by only one thread at a time, so the worker
+     *  speeds up partitioning by decoding while the calling thread analyzes blocks.  Speculation is skipped when the
+     *  "--threads" command-line switch is one.
+     *
+     * @{ */
+    bool speculativeDecoding() const /*final*/ { return settings_.partitioner.speculativeDecoding; }
+    virtual void speculativeDecoding(bool b) { settings_.partitioner.speculativeDecoding = b; }
+    /** @} */
+
+    /** Property: Whether to scan for function prologues in bulk.
+     *
+     *  If set, then @ref discoverFunctions finds function prologues by calling @ref scanPrologueCandidates once and passing
+     *  the results to @ref makePrologueFunctions instead of repeatedly calling @ref makeNextPrologueFunction, which probes
+     *  every unused executable address.  Function prologue matchers that don't publish signatures are consulted only at
+     *  candidate addresses found by the signatures of other matchers.
+     *
+     * @{ */
+    bool bulkPrologueScan() const /*final*/ { return settings_.partitioner.bulkPrologueScan; }
+    virtual void bulkPrologueScan(bool b) { settings_.partitioner.bulkPrologueScan = b; }
+    /** @} */
+
     /** Property: Type of container for semantic memory.
      *
      *  Determines whether @ref Partitioner objects created by this engine will be configured to use list-based or map-based
@@ -5,9 +5,14 @@
 #include "BaseSemantics2.h"
 #include "AstSerialization.h"
 
+#include <boost/atomic.hpp>
+#include <boost/foreach.hpp>
 #include <boost/serialization/access.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
 #include <Sawyer/Assert.h>
 #include <Sawyer/Map.h>
+#include <Sawyer/Optional.h>
 #include <Sawyer/SharedPointer.h>
 
 namespace rose {
@@ -33,11 +38,36 @@ public:
     /** Mapping from address to instruction. */
     typedef Sawyer::Container::Map<rose_addr_t, SgAsmInstruction*> InsnMap;
 
+    /** Cache statistics.
+     *
+     *  @sa statistics */
+    struct Statistics {
+        size_t nHits;                                   /**< Lookups satisfied by the cache. */
+        size_t nMisses;                                 /**< Lookups that had to call a disassembler. */
+        size_t nContentions;                            /**< Times a thread had to wait for another thread's lock. */
+
+        Statistics()
+            : nHits(0), nMisses(0), nContentions(0) {}
+    };
+
 private:
+    // The cache is divided into shards by address, each with its own reader/writer lock. Lookups of cached addresses take
+    // only a shared lock, so they run concurrently with each other and only wait for threads that are inserting into the
+    // same shard.  Shards are selected by page so that the instructions of one basic block are usually in the same shard.
+    static const size_t N_SHARDS = 64;
+    static const size_t SHARD_PAGE_BITS = 12;
+
+    struct Shard {
+        mutable boost::shared_mutex mutex;              // protects insns
+        InsnMap insns;
+    };
+
     Disassembler *disassembler_;
     MemoryMap::Ptr memMap_;
-    mutable InsnMap insnMap_;                           // this is a cache
+    mutable Shard shards_[N_SHARDS];                    // this is a cache
+    mutable boost::mutex decodeMutex_;                  // serializes decoding, which allocates IR nodes
     bool useDisassembler_;
+    mutable boost::atomic<size_t> nHits_, nMisses_, nContentions_;
 
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 private:
@@ -50,6 +80,7 @@ private:
         s <<BOOST_SERIALIZATION_NVP(hasDisassembler);
         s <<BOOST_SERIALIZATION_NVP(useDisassembler_);
         s <<BOOST_SERIALIZATION_NVP(memMap_);
+        InsnMap insnMap_ = allInstructions();           // the archive has a single map, named as before sharding
         s <<BOOST_SERIALIZATION_NVP(insnMap_);
         if (hasDisassembler) {
             std::string disName = disassembler_->name();
@@ -64,7 +95,10 @@ private:
         s >>BOOST_SERIALIZATION_NVP(hasDisassembler);
         s >>BOOST_SERIALIZATION_NVP(useDisassembler_);
         s >>BOOST_SERIALIZATION_NVP(memMap_);
+        InsnMap insnMap_;
         s >>BOOST_SERIALIZATION_NVP(insnMap_);
+        BOOST_FOREACH (const InsnMap::Node &node, insnMap_.nodes())
+            shard(node.key()).insns.insert(node.key(), node.value());
         if (hasDisassembler) {
             std::string disName;
             s >>BOOST_SERIALIZATION_NVP(disName);
@@ -78,10 +112,10 @@ private:
 
 protected:
     InstructionProvider()
-        : disassembler_(NULL), useDisassembler_(false) {}
+        : disassembler_(NULL), useDisassembler_(false), nHits_(0), nMisses_(0), nContentions_(0) {}
 
     InstructionProvider(Disassembler *disassembler, const MemoryMap::Ptr &map)
-        : disassembler_(disassembler), memMap_(map), useDisassembler_(true) {
+        : disassembler_(disassembler), memMap_(map), useDisassembler_(true), nHits_(0), nMisses_(0), nContentions_(0) {
         ASSERT_not_null(disassembler);
     }
 
@@ -119,6 +153,11 @@ public:
     /** @} */
 
     /** Returns the instruction at the specified virtual address, or null.
+     *
+     *  This method is thread safe.  Concurrent calls are permitted, but since the disassembler supplied to the constructor is
+     *  not thread safe, threads other than the one that normally uses this provider should call @ref decode with their own
+     *  disassembler when the address might not be cached yet.
+     *
      *
      *  If the virtual address is non-executable then a null pointer is returned, otherwise either a valid instruction or an
      *  "unknown" instruction is returned.  An "unknown" instruction is used for cases where a valid instruction could not be
@@ -126,10 +165,27 @@ public:
      *  are not executable. */
     SgAsmInstruction* operator[](rose_addr_t va) const;
 
+    /** Returns the instruction at the specified virtual address using the specified disassembler.
+     *
+     *  This is the same as @ref operator[] except that if the address is not cached then the instruction is obtained from the
+     *  specified disassembler instead of the one supplied to the constructor.  The cache is thread safe but disassemblers are
+     *  not, so threads that obtain instructions concurrently must each use their own disassembler (see @ref
+     *  Disassembler::clone).  Decoding allocates IR nodes, so only one thread decodes at a time; lookups of addresses that
+     *  are already cached do not wait for the decoder.  An address is decoded at most once, and the instruction cached for it
+     *  is returned to all threads. */
+    SgAsmInstruction* decode(rose_addr_t va, Disassembler*) const;
+
+    /** Whether an address is cached.
+     *
+     *  Returns true if the cache has an entry for the specified address, regardless of whether that entry is an instruction
+     *  or a null pointer. */
+    bool isCached(rose_addr_t va) const;
+
     /** Insert an instruction into the cache.
      *
      *  This instruction provider saves a pointer to the instruction without taking ownership.  If an instruction already
-     *  exists at the new instruction's address then the new instruction replaces the old instruction. */
+     *  exists at the new instruction's address then the new instruction replaces the old instruction.  This must not be
+     *  called while other threads are decoding instructions. */
     void insert(SgAsmInstruction*);
 
     /** Returns the disassembler.
@@ -143,8 +199,18 @@ public:
      *  The number of cached starting addresses includes those addresses where an instruction exists, and those addresses where
      *  an instruction is known to not exist.
      *
-     *  This is a constant-time operation. */
-    size_t nCached() const { return insnMap_.size(); }
+     *  The time is proportional to the number of shards. */
+    size_t nCached() const;
+
+    /** Cache statistics.
+     *
+     *  Returns counts of cache hits, misses, and lock contention accumulated since the provider was created or since the
+     *  last call to @ref resetStatistics.
+     *
+     * @{ */
+    Statistics statistics() const;
+    void resetStatistics();
+    /** @} */
 
     /** Returns the register dictionary. */
     const RegisterDictionary* registerDictionary() const { return disassembler_->get_registers(); }
@@ -172,6 +238,17 @@ public:
      *  in which case a null pointer is returned.  The returned dispatcher is not connected to any semantic domain, so it can
      *  only be used to call its virtual constructor to create a valid dispatcher. */
     InstructionSemantics2::BaseSemantics::DispatcherPtr dispatcher() const { return disassembler_->dispatcher(); }
+
+private:
+    Shard& shard(rose_addr_t va) const {
+        return shards_[(va >> SHARD_PAGE_BITS) % N_SHARDS];
+    }
+
+    // Look up an address in the cache.
+    Sawyer::Optional<SgAsmInstruction*> find(rose_addr_t va) const;
+
+    // All cached instructions in a single map.
+    InsnMap allInstructions() const;
 };
 
 } // namespace
@@ -122,6 +122,14 @@ public:
      *
      *  The partitioner will never call @ref function without first having called @ref match. */
     virtual std::vector<Function::Ptr> functions() const = 0;
+
+    /** Byte sequences at which a match can start.
+     *
+     *  A matcher whose @ref match method can only succeed at an anchor whose memory begins with one of a few known byte
+     *  sequences can return those sequences so that the engine can find candidate anchors by scanning memory in bulk rather
+     *  than invoking @ref match at every address (see @ref Engine::scanPrologueCandidates).  The default implementation
+     *  returns an empty vector, which means the matcher has no such signatures. */
+    virtual std::vector<std::vector<uint8_t> > signatures() const { return std::vector<std::vector<uint8_t> >(); }
 };
 
 
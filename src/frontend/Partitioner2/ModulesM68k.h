@@ -20,6 +20,7 @@ public:
     static Ptr instance() { return Ptr(new MatchLink); }
     virtual std::vector<Function::Ptr> functions() const ROSE_OVERRIDE { return std::vector<Function::Ptr>(1, function_); }
     virtual bool match(const Partitioner&, rose_addr_t anchor) ROSE_OVERRIDE;
+    virtual std::vector<std::vector<uint8_t> > signatures() const ROSE_OVERRIDE;
 };
 
 /** Matches M68k function padding. */
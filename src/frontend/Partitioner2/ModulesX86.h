@@ -26,6 +26,7 @@ public:
     static Ptr instance() { return Ptr(new MatchStandardPrologue); } /**< Allocating constructor. */
     virtual std::vector<Function::Ptr> functions() const ROSE_OVERRIDE { return std::vector<Function::Ptr>(1, function_); }
     virtual bool match(const Partitioner &partitioner, rose_addr_t anchor) ROSE_OVERRIDE;
+    virtual std::vector<std::vector<uint8_t> > signatures() const ROSE_OVERRIDE;
 };
 
 /** Matches an x86 function prologue with hot patch.
@@ -41,6 +42,7 @@ public:
     static Ptr instance() { return Ptr(new MatchHotPatchPrologue); } /**< Allocating constructor. */
     virtual std::vector<Function::Ptr> functions() const ROSE_OVERRIDE { return std::vector<Function::Ptr>(1, function_); }
     virtual bool match(const Partitioner &partitioner, rose_addr_t anchor) ROSE_OVERRIDE;
+    virtual std::vector<std::vector<uint8_t> > signatures() const ROSE_OVERRIDE;
 };
 
 /** Matches an x86 <code>MOV EDI,EDI; PUSH ESI</code> function prologe. */
@@ -51,6 +53,7 @@ public:
     static Ptr instance() { return Ptr(new MatchAbbreviatedPrologue); }
     virtual std::vector<Function::Ptr> functions() const ROSE_OVERRIDE { return std::vector<Function::Ptr>(1, function_); }
     virtual bool match(const Partitioner &partitioner, rose_addr_t anchor) ROSE_OVERRIDE;
+    virtual std::vector<std::vector<uint8_t> > signatures() const ROSE_OVERRIDE;
 };
 
 /** Matches an x86 "ENTER xxx, 0" prologue. */
@@ -1882,6 +1882,13 @@ public:
      *  If no match is found then an empty vector is returned. */
     std::vector<Function::Ptr> nextFunctionPrologue(rose_addr_t startVa) /*final*/;
 
+    /** Matches a function prologue at one address.
+     *
+     *  This is like @ref nextFunctionPrologue except it tries the function prologue matchers only at @p va, which must be
+     *  mapped with execute permission and must not be represented in the CFG/AUM.  Returns the detached function(s) from the
+     *  first matcher that succeeds, or an empty vector if none succeed or @p va doesn't meet the preconditions. */
+    std::vector<Function::Ptr> matchFunctionPrologue(rose_addr_t va) /*final*/;
+
 public:
     /** Ordered list of function padding matchers.
      *
@@ -1078,6 +1078,29 @@ class EasyStorage < std::map<SgNode*, std::string> >
      static void readFromFile (std::istream& in);
    };
 
+// EasyStorage for the hashed name caches of SgNode (rose_node_string_hash_map and rose_string_integer_hash_map).
+// * the data is stored exactly as for the std::map versions these caches used to be, so they share the memory
+//   pools (and the static methods) of those classes; only the conversion to and from the hashed map is added.
+template <>
+class EasyStorage < rose_node_string_hash_map > 
+   : public EasyStorage < std::map<SgNode*, std::string> >
+   {
+     typedef EasyStorage < std::map<SgNode*, std::string> > Base;
+    public:
+     void storeDataInEasyStorageClass(const rose_node_string_hash_map& data_);
+     rose_node_string_hash_map rebuildDataStoredInEasyStorageClass() const;
+   };
+
+template <>
+class EasyStorage < rose_string_integer_hash_map > 
+   : public EasyStorage < std::map<std::string, int> >
+   {
+     typedef EasyStorage < std::map<std::string, int> > Base;
+    public:
+     void storeDataInEasyStorageClass(const rose_string_integer_hash_map& data_);
+     rose_string_integer_hash_map rebuildDataStoredInEasyStorageClass() const;
+   };
+
 // Liao 1/23/2013, placeholder for storing std::map <SgSymbol*, std::vector <std::pair <SgExpression*, SgExpression*> > >
 // this is used for representing array dimension information of the map clause.
 // TODO: provide real storage support once the OpenMP Accelerator Model is standardized.
@@ -302,6 +302,19 @@
    #error "DEFAULT_CLASS_ALLOCATION_POOL_SIZE must be greater than zero!"
 #endif
 
+// Each time a memory pool runs out of free objects it allocates twice as many blocks of DEFAULT_CLASS_ALLOCATION_POOL_SIZE
+// objects as the previous time, up to this many blocks per allocation.  The blocks themselves stay the same size since the
+// AST File I/O indexes the pool by block.
+#define MAX_CLASS_ALLOCATION_BLOCKS_PER_MALLOC 64
+
+// Number of free objects moved at once between a memory pool and a thread's allocation cache when ROSE is configured for
+// multi-threading. A thread's cache holds at most twice this many objects.
+#define CLASS_ALLOCATION_THREAD_CACHE_BATCH 64
+
+#if MAX_CLASS_ALLOCATION_BLOCKS_PER_MALLOC < 1 || CLASS_ALLOCATION_THREAD_CACHE_BATCH < 1
+   #error "MAX_CLASS_ALLOCATION_BLOCKS_PER_MALLOC and CLASS_ALLOCATION_THREAD_CACHE_BATCH must be greater than zero!"
+#endif
+
 // DQ (3/7/2010): This is no longer used (for several years) and we use an STL based implementation.
 // #define MAX_NUMBER_OF_MEMORY_BLOCKS        1000
 
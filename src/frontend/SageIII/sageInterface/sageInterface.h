@@ -509,6 +509,20 @@ struct hash_nodeptr
   std::string getMangledNameFromCache (SgNode * astNode);
   std::string addMangledNameToCache (SgNode * astNode, const std::string & mangledName);
 
+  /*! \brief Returns a 64-bit fingerprint of the mangled name of astNode (zero if its mangled name is not cached).
+
+      Two declarations with the same mangled name have the same fingerprint, so the fingerprints can be compared
+      before (or instead of) comparing the mangled names.
+   */
+  uint64_t getMangledNameFingerprint (SgNode * astNode);
+
+  /*! \brief Returns true if the two declarations have the same mangled name.
+
+      The fingerprints of the mangled names are compared first, and the mangled names are compared only if the fingerprints
+      match or if either mangled name is not cached.
+   */
+  bool hasSameMangledName (SgDeclarationStatement * declA, SgDeclarationStatement * declB);
+
   SgDeclarationStatement * getNonInstantiatonDeclarationForClass (SgTemplateInstantiationMemberFunctionDecl * memberFunctionInstantiation);
 
   //! a better version for SgVariableDeclaration::set_baseTypeDefininingDeclaration(), handling all side effects automatically
@@ -1692,7 +1692,8 @@ OptionRequiresArgument (const std::string& option)
 {
   return
       // ROSE Options
-      option == "-rose:unparser:some_option_taking_argument";
+      option == "-rose:unparser:some_option_taking_argument" ||
+      option == "-rose:unparser:parallel";
 }// ::Rose::Cmdline:Unparser:::OptionRequiresArgument
 
 void
@@ -1709,6 +1710,8 @@ StripRoseOptions (std::vector<std::string>& argv)
   //
   // (2) Options WITH an argument
   //
+  int integerOption_parallel = 0;
+  sla(argv, "-rose:unparser:", "($)^", "(parallel)", &integerOption_parallel, 1);
 
   // Remove Unparser options with ROSE-unparser prefix; option arguments removed
   // by generateOptionWithNameParameterList.
@@ -1733,6 +1736,7 @@ Process (SgProject* project, std::vector<std::string>& argv)
       std::cout << "[INFO] Processing Unparser commandline options" << std::endl;
 
   ProcessClobberInputFile(project, argv);
+  ProcessParallel(project, argv);
 }// ::Rose::Cmdline::Unparser::Process
 
 void
@@ -1759,6 +1763,32 @@ ProcessClobberInputFile (SgProject* project, std::vector<std::string>& argv)
   }
 }// ::Rose::Cmdline::Unparser::ProcessClobberInputFile
 
+void
+Rose::Cmdline::Unparser::
+ProcessParallel (SgProject* project, std::vector<std::string>& argv)
+{
+  int number_of_processes = 0;
+
+  bool has_parallel =
+      // -rose:unparser:parallel N
+      CommandlineProcessing::isOptionWithParameter(
+          argv,
+          Cmdline::Unparser::option_prefix,
+          "parallel",
+          number_of_processes,
+          Cmdline::REMOVE_OPTION_FROM_ARGV);
+
+  if (has_parallel && SgProject::get_verbose() > 1)
+  {
+      std::cout
+          << "[INFO] Unparsing the files with "
+          << number_of_processes << " worker processes"
+          << std::endl;
+  }
+
+  project->set_unparser__parallel(has_parallel ? number_of_processes : 0);
+}// ::Rose::Cmdline::Unparser::ProcessParallel
+
 //------------------------------------------------------------------------------
 //                                  Fortran
 //------------------------------------------------------------------------------
@@ -3294,6 +3324,12 @@ SgFile::usage ( int status )
 "                             statements, where as the token_trailing_* file uses the mapping \n"
 "                             and the trailing whitespace mapping between statements.  Both \n"
 "                             files should be identical, and the same as the input file. \n"
+"     -rose:incremental_name_qualification\n"
+"                             recompute the name qualification only for the declarations\n"
+"                             that changed since the file was last unparsed\n"
+"     -rose:validate_incremental_name_qualification\n"
+"                             same as -rose:incremental_name_qualification, and compare the\n"
+"                             result with a full recomputation (testing)\n"
 "     -rose:unparse_template_ast\n"
 "                             unparse C++ templates from their AST, not from strings stored by EDG. \n"
 "     -rose:embedColorCodesInGeneratedCode LEVEL\n"
@@ -3383,6 +3419,9 @@ SgFile::usage ( int status )
 "                               that with this option you use ROSE, and run your build\n"
 "                               system, sequentially.\n"
 "                               **CAUTION**RED*ALERT**CAUTION**\n"
+"     -rose:unparser:parallel N\n"
+"                               unparse the files of the project (and the header files\n"
+"                               of -rose:unparseHeaderFiles) using N worker processes\n"
 "     -rose:unparse_line_directives\n"
 "                               unparse statements using #line directives with\n"
 "                               reference to the original file and line number\n"
@@ -3725,6 +3764,25 @@ SgFile::processRoseCommandLineOptions ( vector<string> & argv )
           set_unparse_tokens(true);
         }
 
+  //
+  // Incremental name qualification (and its validation against the full recomputation).
+  //
+     set_incremental_name_qualification(false);
+     set_validate_incremental_name_qualification(false);
+     if ( CommandlineProcessing::isOption(argv,"-rose:","(incremental_name_qualification)",true) == true )
+        {
+          if ( SgProject::get_verbose() >= 1 )
+               printf ("incremental name qualification mode ON \n");
+          set_incremental_name_qualification(true);
+        }
+     if ( CommandlineProcessing::isOption(argv,"-rose:","(validate_incremental_name_qualification)",true) == true )
+        {
+          if ( SgProject::get_verbose() >= 1 )
+               printf ("incremental name qualification mode ON (with validation) \n");
+          set_incremental_name_qualification(true);
+          set_validate_incremental_name_qualification(true);
+        }
+
   //
   // DQ (12/14/2015): Added more token handling support to improve the source position infor stored in the AST Sg_File_Info objects.
   // Turn on the output of the tokens from the parser (only applies to C and Fortran support).
@@ -5668,6 +5726,8 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
      optionCount = sla(argv, "-rose:", "($)", "(use_token_stream_to_improve_source_position_info)",1);
 
      optionCount = sla(argv, "-rose:", "($)", "(unparse_template_ast)",1);
+     optionCount = sla(argv, "-rose:", "($)", "(incremental_name_qualification)",1);
+     optionCount = sla(argv, "-rose:", "($)", "(validate_incremental_name_qualification)",1);
   // DQ (12/23/2015): Suppress variable declaration normalizations
      optionCount = sla(argv, "-rose:", "($)", "(suppress_variable_declaration_normalization)",1);
 
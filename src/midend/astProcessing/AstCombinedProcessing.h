@@ -18,6 +18,78 @@
 
 #include "AstProcessing.h"
 
+// Recycles the attribute lists of the combined traversals. These need one
+// list of N attributes (one per traversal) for every node they visit; taking
+// the lists from a free list instead of the heap keeps a combined traversal
+// from spending much of its time in the allocator. The lists handed out are
+// ordinary heap objects, so a list that escapes the traversal (such as the
+// final synthesized result returned by traverse()) may simply be deleted by
+// its new owner.
+template <class ListType>
+class AstCombinedAttributeListPool
+{
+public:
+    AstCombinedAttributeListPool() {}
+    // Copies start out with an empty free list; the lists are not shared.
+    AstCombinedAttributeListPool(const AstCombinedAttributeListPool &) {}
+    AstCombinedAttributeListPool &operator=(const AstCombinedAttributeListPool &) { return *this; }
+
+    ~AstCombinedAttributeListPool()
+    {
+        for (typename std::vector<ListType *>::iterator i = freeLists.begin(); i != freeLists.end(); ++i)
+            delete *i;
+    }
+
+    // Returns an empty list with room for at least n elements.
+    ListType *allocate(typename ListType::size_type n)
+    {
+        ListType *list;
+        if (freeLists.empty())
+        {
+            list = new ListType();
+        }
+        else
+        {
+            list = freeLists.back();
+            freeLists.pop_back();
+            list->clear();
+        }
+        list->reserve(n);
+        return list;
+    }
+
+    // Returns a list obtained from allocate() to the free list.
+    void release(ListType *list)
+    {
+        freeLists.push_back(list);
+    }
+
+private:
+    std::vector<ListType *> freeLists;
+};
+
+// Scratch stack frame holding one traversal's share of the synthesized
+// attributes at a node. Unlike a plain StackFrameVector member, copies of
+// this get their own buffer.
+template <class T>
+class AstCombinedAttributeFrame
+{
+public:
+    AstCombinedAttributeFrame() {}
+    AstCombinedAttributeFrame(const AstCombinedAttributeFrame &) {}
+    AstCombinedAttributeFrame &operator=(const AstCombinedAttributeFrame &) { return *this; }
+
+    // Returns the frame, resized to n elements whose values are unspecified.
+    StackFrameVector<T> &get(typename StackFrameVector<T>::size_type n)
+    {
+        frame.setFrame(n);
+        return frame;
+    }
+
+private:
+    StackFrameVector<T> frame;
+};
+
 template <class InheritedAttributeType, class SynthesizedAttributeType>
 class SgCombinedTreeTraversal
     : public SgTreeTraversal< std::vector<InheritedAttributeType> *, std::vector<SynthesizedAttributeType> *>
@@ -60,6 +132,9 @@ protected:
 private:
     typename TraversalPtrList::iterator tBegin, tEnd;
     typename TraversalPtrList::size_type numberOfTraversals;
+    AstCombinedAttributeListPool<InheritedAttributeTypeList> inheritedListPool;
+    AstCombinedAttributeListPool<SynthesizedAttributeTypeList> synthesizedListPool;
+    AstCombinedAttributeFrame<SynthesizedAttributeType> attributesForTraversal;
 };
 
 template <class InheritedAttributeType, class SynthesizedAttributeType>
@@ -104,6 +179,9 @@ protected:
 private:
     typename TraversalPtrList::iterator tBegin, tEnd;
     typename TraversalPtrList::size_type numberOfTraversals;
+    AstCombinedAttributeListPool<InheritedAttributeTypeList> inheritedListPool;
+    AstCombinedAttributeListPool<SynthesizedAttributeTypeList> synthesizedListPool;
+    AstCombinedAttributeFrame<SynthesizedAttributeType> attributesForTraversal;
 };
 
 template <class InheritedAttributeType>
@@ -141,6 +219,7 @@ protected:
 private:
     typename TraversalPtrList::iterator tBegin, tEnd;
     typename TraversalPtrList::size_type numberOfTraversals;
+    AstCombinedAttributeListPool<InheritedAttributeTypeList> inheritedListPool;
 };
 
 template <class SynthesizedAttributeType>
@@ -180,6 +259,8 @@ protected:
 private:
     typename TraversalPtrList::iterator tBegin, tEnd;
     typename TraversalPtrList::size_type numberOfTraversals;
+    AstCombinedAttributeListPool<SynthesizedAttributeTypeList> synthesizedListPool;
+    AstCombinedAttributeFrame<SynthesizedAttributeType> attributesForTraversal;
 };
 
 #include "AstCombinedProcessingImpl.h"
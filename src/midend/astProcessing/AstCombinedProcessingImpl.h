@@ -52,11 +52,11 @@ evaluateInheritedAttribute(SgNode *astNode,
         typename SgCombinedTreeTraversal<I, S>
         ::InheritedAttributeTypeList *inheritedValues)
 {
+    // Take a list with just enough space for one inherited attribute per
+    // traversal from the pool, this keeps us from doing expensive
+    // allocation and resizing for every node.
     InheritedAttributeTypeList *result
-        = new InheritedAttributeTypeList();
-    // Reserve just enough space for one inherited attribute per
-    // traversal, this keeps us from doing expensive resizing later.
-    result->reserve(numberOfTraversals);
+        = inheritedListPool.allocate(numberOfTraversals);
 
     // Fill the list by evaluating the inherited attributes for each
     // traversal.
@@ -71,8 +71,8 @@ evaluateInheritedAttribute(SgNode *astNode,
     ROSE_ASSERT(t == tEnd && i == iEnd);
     ROSE_ASSERT(result->size() == numberOfTraversals);
 
-    // The inherited attribute list allocated here should be deleted in the
-    // evaluateSynthesizedAttribute() function.
+    // The inherited attribute list taken from the pool here is returned to
+    // it in the evaluateSynthesizedAttribute() function.
     return result;
 }
 
@@ -94,14 +94,13 @@ evaluateSynthesizedAttribute(SgNode *astNode,
 
     typename SynthesizedAttributesList::size_type M
         = synthesizedAttributes.size();
-    // Create a container of size M in which we will store the synthesized
-    // attributes for each traversal.
-    typename TraversalType::SynthesizedAttributesList
-        attributesForTraversal(M);
-    // Create a list for the traversal results.
+    // Get a container of size M in which we will store the synthesized
+    // attributes for each traversal; its storage is reused across nodes.
+    typename TraversalType::SynthesizedAttributesList &attributes
+        = attributesForTraversal.get(M);
+    // Get a list for the traversal results.
     SynthesizedAttributeTypeList *result
-        = new SynthesizedAttributeTypeList();
-    result->reserve(numberOfTraversals);
+        = synthesizedListPool.allocate(numberOfTraversals);
 
     typename TraversalPtrList::size_type i;
     typename SynthesizedAttributesList::size_type j;
@@ -109,24 +108,24 @@ evaluateSynthesizedAttribute(SgNode *astNode,
     for (i = 0; i < numberOfTraversals; i++)
     {
         for (j = 0; j < M; j++)
-            attributesForTraversal[j] = (*synthesizedAttributes[j])[i];
+            attributes[j] = (*synthesizedAttributes[j])[i];
 
         result->push_back(
                 traversals[i]->evaluateSynthesizedAttribute(
                     astNode,
                     (*inheritedValues)[i],
-                    attributesForTraversal));
+                    attributes));
     }
 
     // The lists of synthesized attributes passed to us are not needed
-    // anymore, free them.
+    // anymore, return them to the pool.
     for (j = 0; j < M; j++)
-        delete synthesizedAttributes[j];
+        synthesizedListPool.release(synthesizedAttributes[j]);
 
-    // inheritedValues is a pointer to a container that is dynamically
-    // allocated in evaluateInheritedAttribute(). Now that all successor
-    // nodes have been visited, we can free the allocated memory.
-    delete inheritedValues;
+    // inheritedValues is a pointer to a container that is taken from the
+    // pool in evaluateInheritedAttribute(). Now that all successor nodes
+    // have been visited, we can give it back.
+    inheritedListPool.release(inheritedValues);
 
     return result;
 }
@@ -138,9 +137,10 @@ SgCombinedTreeTraversal<I, S>::
 defaultSynthesizedAttribute(typename SgCombinedTreeTraversal<I, S>
         ::InheritedAttributeTypeList *inheritedValues)
 {
-    // Create a list for the default attributes.
+    // Get a list for the default attributes.
     SynthesizedAttributeTypeList *result
-        = new SynthesizedAttributeTypeList(numberOfTraversals);
+        = synthesizedListPool.allocate(numberOfTraversals);
+    result->resize(numberOfTraversals);
 
 #if 1
     typename TraversalPtrList::size_type i;
@@ -231,11 +231,11 @@ evaluateInheritedAttribute(SgNode *astNode,
         typename AstCombinedTopDownBottomUpProcessing<I, S>
         ::InheritedAttributeTypeList *inheritedValues)
 {
+    // Take a list with just enough space for one inherited attribute per
+    // traversal from the pool, this keeps us from doing expensive
+    // allocation and resizing for every node.
     InheritedAttributeTypeList *result
-        = new InheritedAttributeTypeList();
-    // Reserve just enough space for one inherited attribute per
-    // traversal, this keeps us from doing expensive resizing later.
-    result->reserve(numberOfTraversals);
+        = inheritedListPool.allocate(numberOfTraversals);
 
     // Fill the list by evaluating the inherited attributes for each
     // traversal.
@@ -250,8 +250,8 @@ evaluateInheritedAttribute(SgNode *astNode,
     ROSE_ASSERT(t == tEnd && i == iEnd);
     ROSE_ASSERT(result->size() == numberOfTraversals);
 
-    // The inherited attribute list allocated here should be deleted in the
-    // evaluateSynthesizedAttribute() function.
+    // The inherited attribute list taken from the pool here is returned to
+    // it in the evaluateSynthesizedAttribute() function.
     return result;
 }
 
@@ -273,14 +273,13 @@ evaluateSynthesizedAttribute(SgNode *astNode,
 
     typename SynthesizedAttributesList::size_type M
         = synthesizedAttributes.size();
-    // Create a container of size M in which we will store the synthesized
-    // attributes for each traversal.
-    typename TraversalType::SynthesizedAttributesList
-        attributesForTraversal(M);
-    // Create a list for the traversal results.
+    // Get a container of size M in which we will store the synthesized
+    // attributes for each traversal; its storage is reused across nodes.
+    typename TraversalType::SynthesizedAttributesList &attributes
+        = attributesForTraversal.get(M);
+    // Get a list for the traversal results.
     SynthesizedAttributeTypeList *result
-        = new SynthesizedAttributeTypeList();
-    result->reserve(numberOfTraversals);
+        = synthesizedListPool.allocate(numberOfTraversals);
 
     typename TraversalPtrList::size_type i;
     typename SynthesizedAttributesList::size_type j;
@@ -288,24 +287,24 @@ evaluateSynthesizedAttribute(SgNode *astNode,
     for (i = 0; i < numberOfTraversals; i++)
     {
         for (j = 0; j < M; j++)
-            attributesForTraversal[j] = (*synthesizedAttributes[j])[i];
+            attributes[j] = (*synthesizedAttributes[j])[i];
 
         result->push_back(
                 traversals[i]->evaluateSynthesizedAttribute(
                     astNode,
                     (*inheritedValues)[i],
-                    attributesForTraversal));
+                    attributes));
     }
 
     // The lists of synthesized attributes passed to us are not needed
-    // anymore, free them.
+    // anymore, return them to the pool.
     for (j = 0; j < M; j++)
-        delete synthesizedAttributes[j];
+        synthesizedListPool.release(synthesizedAttributes[j]);
 
-    // inheritedValues is a pointer to a container that is dynamically
-    // allocated in evaluateInheritedAttribute(). Now that all successor
-    // nodes have been visited, we can free the allocated memory.
-    delete inheritedValues;
+    // inheritedValues is a pointer to a container that is taken from the
+    // pool in evaluateInheritedAttribute(). Now that all successor nodes
+    // have been visited, we can give it back.
+    inheritedListPool.release(inheritedValues);
 
     return result;
 }
@@ -317,9 +316,10 @@ AstCombinedTopDownBottomUpProcessing<I, S>::
 defaultSynthesizedAttribute(typename AstCombinedTopDownBottomUpProcessing<I, S>
         ::InheritedAttributeTypeList *inheritedValues)
 {
-    // Create a list for the default attributes.
+    // Get a list for the default attributes.
     SynthesizedAttributeTypeList *result
-        = new SynthesizedAttributeTypeList(numberOfTraversals);
+        = synthesizedListPool.allocate(numberOfTraversals);
+    result->resize(numberOfTraversals);
 
     typename TraversalPtrList::size_type i;
     for (i = 0; i < numberOfTraversals; i++)
@@ -401,11 +401,11 @@ evaluateInheritedAttribute(SgNode *astNode,
         typename AstCombinedTopDownProcessing<I>
         ::InheritedAttributeTypeList *inheritedValues)
 {
+    // Take a list with just enough space for one inherited attribute per
+    // traversal from the pool, this keeps us from doing expensive
+    // allocation and resizing for every node.
     InheritedAttributeTypeList *result
-        = new InheritedAttributeTypeList();
-    // Reserve just enough space for one inherited attribute per
-    // traversal, this keeps us from doing expensive resizing later.
-    result->reserve(numberOfTraversals);
+        = inheritedListPool.allocate(numberOfTraversals);
 
     // Fill the list by evaluating the inherited attributes for each
     // traversal.
@@ -420,8 +420,8 @@ evaluateInheritedAttribute(SgNode *astNode,
     ROSE_ASSERT(t == tEnd && i == iEnd);
     ROSE_ASSERT(result->size() == numberOfTraversals);
 
-    // The list of inherited attributes allocated here should be freed in
-    // the destroyInheritedAttribute() function.
+    // The list of inherited attributes taken from the pool here is
+    // returned to it in the destroyInheritedValue() function.
     return result;
 }
 
@@ -472,10 +472,10 @@ destroyInheritedValue(SgNode *node, typename AstCombinedTopDownProcessing<I>::
         (*t++)->destroyInheritedValue(node, *i++);
     ROSE_ASSERT(t == tEnd && i == iEnd);
 
-    // inheritedValues is a pointer to a container that is dynamically
-    // allocated in evaluateInheritedAttribute(). Now that all successor
-    // nodes have been visited, we can free the allocated memory.
-    delete inheritedValues;
+    // inheritedValues is a pointer to a container that is taken from the
+    // pool in evaluateInheritedAttribute(). Now that all successor nodes
+    // have been visited, we can give it back.
+    inheritedListPool.release(inheritedValues);
 }
 
 // combined BOTTOM UP implementation
@@ -527,13 +527,13 @@ evaluateSynthesizedAttribute(SgNode *astNode,
 
     typename SynthesizedAttributesList::size_type M
         = synthesizedAttributes.size();
-    // Create a container of size M in which we will store the synthesized
-    // attributes for each traversal.
-    typename TraversalType::SynthesizedAttributesList
-        attributesForTraversal(M, NULL);
-    // Create a list for the traversal results.
+    // Get a container of size M in which we will store the synthesized
+    // attributes for each traversal; its storage is reused across nodes.
+    typename TraversalType::SynthesizedAttributesList &attributes
+        = attributesForTraversal.get(M);
+    // Get a list for the traversal results.
     SynthesizedAttributeTypeList *result
-        = new SynthesizedAttributeTypeList(numberOfTraversals);
+        = synthesizedListPool.allocate(numberOfTraversals);
 
     typename TraversalPtrList::size_type i;
     typename SynthesizedAttributesList::size_type j;
@@ -541,19 +541,19 @@ evaluateSynthesizedAttribute(SgNode *astNode,
     for (i = 0; i < numberOfTraversals; i++)
     {
         for (j = 0; j < M; j++)
-            attributesForTraversal[j] = (*synthesizedAttributes[j])[i];
+            attributes[j] = (*synthesizedAttributes[j])[i];
 
-        (*result)[i]
-            = traversals[i]->evaluateSynthesizedAttribute(
+        result->push_back(
+                traversals[i]->evaluateSynthesizedAttribute(
                     astNode,
-                    attributesForTraversal);
+                    attributes));
     }
     ROSE_ASSERT(result->size() == numberOfTraversals);
 
     // The lists of synthesized attributes passed to us are not needed
-    // anymore, free them.
+    // anymore, return them to the pool.
     for (j = 0; j < M; j++)
-        delete synthesizedAttributes[j];
+        synthesizedListPool.release(synthesizedAttributes[j]);
 
     return result;
 }
@@ -564,9 +564,10 @@ typename AstCombinedBottomUpProcessing<S>
 AstCombinedBottomUpProcessing<S>::
 defaultSynthesizedAttribute()
 {
-    // Create a list for the default attributes.
+    // Get a list for the default attributes.
     SynthesizedAttributeTypeList *result
-        = new SynthesizedAttributeTypeList(numberOfTraversals);
+        = synthesizedListPool.allocate(numberOfTraversals);
+    result->resize(numberOfTraversals);
 
     typename TraversalPtrList::size_type i;
     for (i = 0; i < numberOfTraversals; i++)
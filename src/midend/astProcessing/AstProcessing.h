@@ -74,6 +74,15 @@ SgTreeTraversal_inFileToTraverse(SgNode* node, bool traversalConstraint, SgFile*
 #include "AstSuccessorsSelectors.h"
 #include "StackFrameVector.h"
 
+#include <Sawyer/Sawyer.h>
+#if SAWYER_MULTI_THREADED
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <Sawyer/Graph.h>
+#include <Sawyer/ThreadWorkers.h>
+#endif
+
 // This type is used as a dummy template parameter for those traversals
 // that do not use inherited or synthesized attributes.
 typedef void *DummyAttribute;
@@ -111,6 +120,21 @@ public:
             InheritedAttributeType inheritedValue,
             t_traverseOrder travOrder = preandpostorder);
 
+    // Subtree-parallel version of traverse(). The nodes for which isParallelTraversalSplitPoint() is true (by default,
+    // function definitions) are cut out of the AST together with their subtrees; each such subtree is traversed as an
+    // independent task by a pool of up to nThreads worker threads (zero means one per hardware thread), and the rest
+    // of the AST is traversed by the calling thread: top-down before the tasks run, bottom-up after they have all
+    // finished. The synthesized attributes of the subtrees are combined in the same order as in a sequential traversal,
+    // so the result does not depend on the number of threads or on scheduling. The evaluate*() functions of the
+    // traversal are called concurrently and must therefore be thread-safe; the order in which nodes are visited differs
+    // from traverse() (only the parent/child order is preserved). The AstCombined*Processing classes keep per-traversal
+    // scratch storage and cannot be used this way. Without multi-thread support in ROSE, the tasks are run one after
+    // the other.
+    SynthesizedAttributeType traverseInParallel(SgNode* basenode,
+            InheritedAttributeType inheritedValue,
+            t_traverseOrder travOrder = preandpostorder,
+            size_t nThreads = 0);
+
     // Default destructor/constructor
     virtual ~SgTreeTraversal();
     SgTreeTraversal();
@@ -153,6 +177,11 @@ protected:
     // useful, but it won't hurt to have it.
     virtual void atTraversalEnd();
 
+    // Decides where traverseInParallel() splits the AST into tasks. The default splits off function definitions, which
+    // makes per-function analyses scale with the number of threads. Override this to split at other nodes (such as
+    // namespace definitions); split points nested in another split point's subtree are not split again.
+    virtual bool isParallelTraversalSplitPoint(SgNode* node);
+
     // GB (09/25/2007): This flag determines whether the new index-based traversal mechanism or the more general
     // mechanism based on successor containers is to be used. Indexing should be faster, but it would be quite hard to
     // adapt it to the reverse traversal and other specialized traversals. Thus: This is true by default, and anybody
@@ -162,9 +191,64 @@ protected:
 private:
     void performTraversal(SgNode *basenode,
             InheritedAttributeType inheritedValue,
-            t_traverseOrder travOrder);
+            t_traverseOrder travOrder,
+            SynthesizedAttributesList &stack);
     SynthesizedAttributeType traversalResult();
 
+    // State shared by the phases of traverseInParallel(). The inherited attributes of the nodes above the split points
+    // are recorded in preorder while the tasks are collected and replayed in the same order when the synthesized
+    // attributes are combined, so no evaluate*() function is called twice for a node.
+    struct ParallelTraversalTask
+    {
+        SgNode *node;
+        InheritedAttributeType inheritedValue;
+        SynthesizedAttributeType result;
+
+        ParallelTraversalTask(SgNode *n, InheritedAttributeType inh)
+            : node(n), inheritedValue(inh), result() {}
+    };
+
+    struct ParallelTraversalState
+    {
+        std::vector<ParallelTraversalTask> tasks;
+        std::vector<InheritedAttributeType> spineInheritedValues;
+        size_t nextTask;
+        size_t nextSpineNode;
+#if SAWYER_MULTI_THREADED
+        boost::mutex mutex;                             // protects the following members while the tasks run
+        boost::exception_ptr error;                     // first exception thrown by a task
+#endif
+
+        ParallelTraversalState() : nextTask(0), nextSpineNode(0) {}
+    };
+
+#if SAWYER_MULTI_THREADED
+    // Runs one task of a parallel traversal; copies of this are handed to the worker threads.
+    class ParallelTraversalWorker
+    {
+    public:
+        ParallelTraversalWorker(SgTreeTraversal *traversal, ParallelTraversalState *state, t_traverseOrder travOrder)
+            : traversal(traversal), state(state), travOrder(travOrder) {}
+        void operator()(size_t, size_t taskIndex);
+
+    private:
+        SgTreeTraversal *traversal;
+        ParallelTraversalState *state;
+        t_traverseOrder travOrder;
+    };
+#endif
+
+    void selectTraversalSuccessors(SgNode *node, SuccessorsContainer &succContainer);
+    void collectParallelTraversalTasks(SgNode *node,
+            InheritedAttributeType inheritedValue,
+            t_traverseOrder travOrder,
+            ParallelTraversalState &state);
+    void runParallelTraversalTask(ParallelTraversalState &state, size_t taskIndex, t_traverseOrder travOrder);
+    void combineParallelTraversalResults(SgNode *node,
+            InheritedAttributeType inheritedValue,
+            t_traverseOrder travOrder,
+            ParallelTraversalState &state);
+
     bool useDefaultIndexBasedTraversal;
     bool traversalConstraint;
     SgFile *fileToVisit;
@@ -201,7 +285,11 @@ public:
 
     //! evaluates attributes only at nodes which represent the same file as where the evaluation was started
     SynthesizedAttributeType traverseWithinFile(SgNode* node, InheritedAttributeType inheritedValue);
-    
+
+    //! evaluates attributes on the entire AST, traversing the subtrees below function definitions in parallel on up to
+    //! nThreads threads (zero means one per hardware thread); the evaluate functions must be thread-safe. The result
+    //! is the same as that of traverse(). See SgTreeTraversal::traverseInParallel() for details.
+    SynthesizedAttributeType traverseInParallel(SgNode* node, InheritedAttributeType inheritedValue, size_t nThreads = 0);
 
     friend class AstCombinedTopDownBottomUpProcessing<InheritedAttributeType, SynthesizedAttributeType>;
 
@@ -383,6 +471,15 @@ setNodeSuccessors(SgNode* node, SuccessorsContainer& succContainer)
 
 
 
+template<class InheritedAttributeType, class SynthesizedAttributeType>
+bool
+SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+isParallelTraversalSplitPoint(SgNode* node)
+{
+    return isSgFunctionDefinition(node) != NULL;
+}
+
+
 // The default constructor of the internal tree traversal class
 template<class InheritedAttributeType, class SynthesizedAttributeType>
 SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
@@ -504,6 +601,15 @@ traverseWithinFile(SgNode* node, InheritedAttributeType inheritedValue)
     return SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::traverseWithinFile(node, inheritedValue, preandpostorder);
 }
 
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+SynthesizedAttributeType
+AstTopDownBottomUpProcessing<InheritedAttributeType, SynthesizedAttributeType>::
+traverseInParallel(SgNode* node, InheritedAttributeType inheritedValue, size_t nThreads)
+{
+    return SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>
+        ::traverseInParallel(node, inheritedValue, preandpostorder, nThreads);
+}
+
 ////////////////////////////////////////////
 //// TOP DOWN PROCESSING IMPLEMENTATION ////
 ////////////////////////////////////////////
@@ -733,7 +839,7 @@ traverse(SgNode *node, InheritedAttributeType inheritedValue,
     atTraversalStart();
 
     // perform the actual traversal
-    performTraversal(node, inheritedValue, treeTraversalOrder);
+    performTraversal(node, inheritedValue, treeTraversalOrder, *synthesizedAttributes);
 
     // notify the traversal that we are done
     atTraversalEnd();
@@ -743,13 +849,183 @@ traverse(SgNode *node, InheritedAttributeType inheritedValue,
 }
 
 
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+SynthesizedAttributeType SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+traverseInParallel(SgNode *node, InheritedAttributeType inheritedValue,
+        t_traverseOrder treeTraversalOrder, size_t nThreads)
+{
+    synthesizedAttributes->resetStack();
+    ROSE_ASSERT(synthesizedAttributes->debugSize() == 0);
+
+    atTraversalStart();
+
+    // Phase 1: walk the AST down to the split points, evaluating the inherited attributes on the way.
+    ParallelTraversalState state;
+    collectParallelTraversalTasks(node, inheritedValue, treeTraversalOrder, state);
+
+    // Phase 2: traverse the subtrees below the split points. The subtrees are independent of each other, so the task
+    // graph has no edges and the workers simply take the next task from the shared work list when they are done.
+#if SAWYER_MULTI_THREADED
+    if (nThreads != 1 && state.tasks.size() > 1)
+    {
+        Sawyer::Container::Graph<size_t> tasks;
+        for (size_t i = 0; i < state.tasks.size(); i++)
+            tasks.insertVertex(i);
+        Sawyer::workInParallel(tasks, nThreads, ParallelTraversalWorker(this, &state, treeTraversalOrder));
+        if (state.error)
+            boost::rethrow_exception(state.error);
+    }
+    else
+#endif
+    {
+        for (size_t i = 0; i < state.tasks.size(); i++)
+            runParallelTraversalTask(state, i, treeTraversalOrder);
+    }
+
+    // Phase 3: evaluate the synthesized attributes above the split points, using the subtrees' results.
+    if (treeTraversalOrder & postorder)
+        combineParallelTraversalResults(node, inheritedValue, treeTraversalOrder, state);
+
+    atTraversalEnd();
+
+    return traversalResult();
+}
+
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+selectTraversalSuccessors(SgNode *node, SuccessorsContainer &succContainer)
+{
+    if (useDefaultIndexBasedTraversal)
+    {
+        size_t numberOfSuccessors = node->get_numberOfTraversalSuccessors();
+        succContainer.reserve(numberOfSuccessors);
+        for (size_t idx = 0; idx < numberOfSuccessors; idx++)
+            succContainer.push_back(node->get_traversalSuccessorByIndex(idx));
+    }
+    else
+    {
+        setNodeSuccessors(node, succContainer);
+    }
+}
+
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+collectParallelTraversalTasks(SgNode *node, InheritedAttributeType inheritedValue,
+        t_traverseOrder treeTraversalOrder, ParallelTraversalState &state)
+{
+    // Null nodes and nodes outside the file being traversed get their default attribute in phase 3.
+    if (node == NULL || !SgTreeTraversal_inFileToTraverse(node, traversalConstraint, fileToVisit))
+        return;
+
+    // The task evaluates the split point's own attributes, so it gets the inherited attribute of the parent.
+    if (isParallelTraversalSplitPoint(node))
+    {
+        state.tasks.push_back(ParallelTraversalTask(node, inheritedValue));
+        return;
+    }
+
+    if (treeTraversalOrder & preorder)
+        inheritedValue = evaluateInheritedAttribute(node, inheritedValue);
+    state.spineInheritedValues.push_back(inheritedValue);
+
+    SuccessorsContainer succContainer;
+    selectTraversalSuccessors(node, succContainer);
+    for (size_t idx = 0; idx < succContainer.size(); idx++)
+        collectParallelTraversalTasks(succContainer[idx], inheritedValue, treeTraversalOrder, state);
+}
+
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+runParallelTraversalTask(ParallelTraversalState &state, size_t taskIndex, t_traverseOrder treeTraversalOrder)
+{
+    // Each task has its own stack of synthesized attributes, so tasks share nothing but the traversal object.
+    ParallelTraversalTask &task = state.tasks[taskIndex];
+    SynthesizedAttributesList stack;
+    performTraversal(task.node, task.inheritedValue, treeTraversalOrder, stack);
+    if (treeTraversalOrder & postorder)
+    {
+        ROSE_ASSERT(stack.debugSize() == 1);
+        task.result = stack.pop();
+    }
+}
+
+
+#if SAWYER_MULTI_THREADED
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::ParallelTraversalWorker::
+operator()(size_t, size_t taskIndex)
+{
+    // Once a task has failed, the remaining ones are skipped and the first exception is rethrown by the calling thread.
+    {
+        boost::lock_guard<boost::mutex> lock(state->mutex);
+        if (state->error)
+            return;
+    }
+
+    try
+    {
+        traversal->runParallelTraversalTask(*state, taskIndex, travOrder);
+    }
+    catch (...)
+    {
+        boost::lock_guard<boost::mutex> lock(state->mutex);
+        if (!state->error)
+            state->error = boost::current_exception();
+    }
+}
+#endif
+
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+combineParallelTraversalResults(SgNode *node, InheritedAttributeType inheritedValue,
+        t_traverseOrder treeTraversalOrder, ParallelTraversalState &state)
+{
+    // This walks the same nodes in the same order as collectParallelTraversalTasks(), consuming the recorded inherited
+    // attributes and the task results, and maintains the stack exactly like performTraversal().
+    if (node == NULL || !SgTreeTraversal_inFileToTraverse(node, traversalConstraint, fileToVisit))
+    {
+        synthesizedAttributes->push(defaultSynthesizedAttribute(inheritedValue));
+        return;
+    }
+
+    if (isParallelTraversalSplitPoint(node))
+    {
+        ROSE_ASSERT(state.nextTask < state.tasks.size());
+        synthesizedAttributes->push(state.tasks[state.nextTask++].result);
+        return;
+    }
+
+    ROSE_ASSERT(state.nextSpineNode < state.spineInheritedValues.size());
+    inheritedValue = state.spineInheritedValues[state.nextSpineNode++];
+
+    SuccessorsContainer succContainer;
+    selectTraversalSuccessors(node, succContainer);
+    for (size_t idx = 0; idx < succContainer.size(); idx++)
+        combineParallelTraversalResults(succContainer[idx], inheritedValue, treeTraversalOrder, state);
+
+    synthesizedAttributes->setFrameSize(succContainer.size());
+    ROSE_ASSERT(synthesizedAttributes->size() == succContainer.size());
+    synthesizedAttributes->push(evaluateSynthesizedAttribute(node, inheritedValue, *synthesizedAttributes));
+}
+
+
 
 template<class InheritedAttributeType, class SynthesizedAttributeType>
 void
 SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
 performTraversal(SgNode* node,
         InheritedAttributeType inheritedValue,
-        t_traverseOrder treeTraversalOrder)
+        t_traverseOrder treeTraversalOrder,
+        SynthesizedAttributesList &stack)
    {
     //cout << "In SgNode version" << endl;
   // 1. node can be a null pointer, only traverse it if !
@@ -770,55 +1046,39 @@ performTraversal(SgNode* node,
        // Visit the traversable data members of this AST node.
        // GB (09/25/2007): Added support for index-based traversals. The useDefaultIndexBasedTraversal flag tells us
        // whether to use successor containers or direct index-based access to the node's successors.
-          AstSuccessorsSelectors::SuccessorsContainer succContainer;
+       // Null successors are passed on as well: performTraversal() pushes the default synthesized attribute for them,
+       // which keeps the stack frame in step with the successor indices.
           size_t numberOfSuccessors;
-          if (!useDefaultIndexBasedTraversal)
-             {
-               setNodeSuccessors(node, succContainer);
-               numberOfSuccessors = succContainer.size();
-             }
-            else
+          if (useDefaultIndexBasedTraversal)
              {
+            // The index-based path does not build a successor container, so visiting a node allocates nothing
+            // (beyond the occasional growth of the synthesized attribute stack, whose storage is kept between
+            // traversals).
                numberOfSuccessors = node->get_numberOfTraversalSuccessors();
-             }
-
-          for (size_t idx = 0; idx < numberOfSuccessors; idx++)
-             {
-               SgNode *child = NULL;
-
-               if (useDefaultIndexBasedTraversal)
+               for (size_t idx = 0; idx < numberOfSuccessors; idx++)
                   {
-                 // ROSE_ASSERT(node->get_traversalSuccessorByIndex(idx) != NULL || node->get_traversalSuccessorByIndex(idx) == NULL);
-                    child = node->get_traversalSuccessorByIndex(idx);
+                    SgNode *child = node->get_traversalSuccessorByIndex(idx);
 
                  // DQ (4/21/2014): Valgrind test to isolate uninitialised read reported where child is read below.
                     ROSE_ASSERT(child == NULL || child != NULL);
+
+                    performTraversal(child, inheritedValue, treeTraversalOrder, stack);
                   }
-                 else
+             }
+            else
+             {
+            // Custom successor selection (e.g., the reverse traversals) still goes through a container.
+               AstSuccessorsSelectors::SuccessorsContainer succContainer;
+               setNodeSuccessors(node, succContainer);
+               numberOfSuccessors = succContainer.size();
+               for (size_t idx = 0; idx < numberOfSuccessors; idx++)
                   {
-                 // ROSE_ASSERT(succContainer[idx] != NULL || succContainer[idx] == NULL);
-                    child = succContainer[idx];
+                    SgNode *child = succContainer[idx];
 
                  // DQ (4/21/2014): Valgrind test to isolate uninitialised read reported where child is read below.
                     ROSE_ASSERT(child == NULL || child != NULL);
-                  }
 
-               if (child != NULL)
-                  {
-                
-                    
-                   
-                        performTraversal(child, inheritedValue, treeTraversalOrder);
-                        
-                
-                   
-                //ENDEDIT
-                   }
-                 else
-                  {
-                 // null pointer (not traversed): we put the default value(s) of SynthesizedAttribute onto the stack
-                    if (treeTraversalOrder & postorder)
-                         synthesizedAttributes->push(defaultSynthesizedAttribute(inheritedValue));
+                    performTraversal(child, inheritedValue, treeTraversalOrder, stack);
                   }
              }
  
@@ -837,15 +1097,15 @@ performTraversal(SgNode* node,
             // evaluateSynthesizedAttribute(); then replace those results by
             // pushing the computed value onto the stack (which pops off the
             // previous stack frame).
-               synthesizedAttributes->setFrameSize(numberOfSuccessors);
-               ROSE_ASSERT(synthesizedAttributes->size() == numberOfSuccessors);
-               synthesizedAttributes->push(evaluateSynthesizedAttribute(node, inheritedValue, *synthesizedAttributes));
+               stack.setFrameSize(numberOfSuccessors);
+               ROSE_ASSERT(stack.size() == numberOfSuccessors);
+               stack.push(evaluateSynthesizedAttribute(node, inheritedValue, stack));
              }
         }
        else // if (node && inFileToTraverse(node))
         {
           if (treeTraversalOrder & postorder)
-               synthesizedAttributes->push(defaultSynthesizedAttribute(inheritedValue));
+               stack.push(defaultSynthesizedAttribute(inheritedValue));
         }
        } // function body
 
@@ -71,6 +71,10 @@ public:
     //! traverse only nodes which represent files which were specified on the command line (=input files).
     void traverseInputFiles(SgProject* projectNode, Order treeTraversalOrder);
 
+    //! traverse the entire AST, visiting the subtrees below function definitions in parallel on up to nThreads threads
+    //! (zero means one per hardware thread); visit() must be thread-safe. See SgTreeTraversal::traverseInParallel().
+    void traverseInParallel(SgNode* node, Order treeTraversalOrder, size_t nThreads = 0);
+
     friend class AstCombinedSimpleProcessing;
 
 protected:
@@ -125,6 +125,13 @@ public:
     // leaving junk on the stack, then uses that traversal object again.
     void resetStack();
 
+    // Clear the stack and make it consist of a single frame of n elements,
+    // reusing the buffer's storage where possible. The elements are not
+    // reinitialized; the caller is expected to overwrite all of them. This
+    // is used by the combined traversals, which need a scratch frame of
+    // varying size for every node and should not allocate one each time.
+    void setFrame(size_type n);
+
     // Pops the top element off the stack, returns it, and adjusts the
     // stack pointer accordingly. Note that this makes sense primarily if
     // the stack (not just the current frame!) contains exactly one element.
@@ -426,6 +433,17 @@ StackFrameVector<T>::resetStack()
     framePtr = stackPtr = buffer->begin();
 }
 
+template <class T>
+void
+StackFrameVector<T>::setFrame(typename StackFrameVector<T>::size_type n)
+{
+    ROSE_ASSERT(buffer != NULL);
+    if (buffer->size() < n)
+        buffer->resize(n);
+    framePtr = buffer->begin();
+    stackPtr = framePtr + n;
+}
+
 template <class T>
 typename StackFrameVector<T>::value_type
 StackFrameVector<T>::pop()
@@ -450,7 +450,7 @@ private:
         VertexList *forward_order;
         FlowOrder(VertexList *forward_order): forward_order(forward_order) {}
         void compute(const ControlFlowGraph &g, Vertex v0, ReverseVertexList *reverse_order);
-        void finish_vertex(Vertex v, ControlFlowGraph g);
+        void finish_vertex(Vertex v, const ControlFlowGraph &g);
     };
 
     /* Helper class for build_block_cfg_from_ast().  Adds vertices to its 'cfg' member. Vertices are any SgAsmBlock that
@@ -528,7 +528,7 @@ private:
         typedef std::vector<Vertex> Vector;
         Vector &blocks;
         ReturnBlocks(Vector &blocks): blocks(blocks) {}
-        void finish_vertex(Vertex v, ControlFlowGraph g);
+        void finish_vertex(Vertex v, const ControlFlowGraph &g);
     };
 
 public:
@@ -947,7 +947,7 @@ ControlFlow::FlowOrder<ControlFlowGraph>::compute(const ControlFlowGraph &g, Ver
 
 template<class ControlFlowGraph>
 void
-ControlFlow::FlowOrder<ControlFlowGraph>::finish_vertex(Vertex v, ControlFlowGraph g) {
+ControlFlow::FlowOrder<ControlFlowGraph>::finish_vertex(Vertex v, const ControlFlowGraph &g) {
     forward_order->push_back(v);
 }
 
@@ -964,7 +964,7 @@ ControlFlow::flow_order(const ControlFlowGraph &cfg,
 
 template<class ControlFlowGraph>
 void
-ControlFlow::ReturnBlocks<ControlFlowGraph>::finish_vertex(Vertex v, ControlFlowGraph g)
+ControlFlow::ReturnBlocks<ControlFlowGraph>::finish_vertex(Vertex v, const ControlFlowGraph &g)
 {
     typename boost::graph_traits<ControlFlowGraph>::out_edge_iterator ei, ei_end;
     boost::tie(ei, ei_end) = boost::out_edges(v, g);
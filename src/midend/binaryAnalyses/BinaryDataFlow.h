@@ -7,9 +7,15 @@
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/type_traits/is_base_of.hpp>
 #include <list>
+#include <Sawyer/Graph.h>
 #include <Sawyer/GraphTraversal.h>
 #include <Sawyer/DistinctList.h>
+#include <Sawyer/ThreadWorkers.h>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -231,6 +237,12 @@ public:
         }
     };
     
+    /** Order in which a data-flow engine visits pending vertices. */
+    enum WorkListOrder {
+        INSERTION_ORDER,                                /**< Visit vertices in the order they were added to the work list. */
+        REVERSE_POSTORDER                               /**< Visit the pending vertex that's earliest in reverse post-order. */
+    };
+
     /** Data-flow engine.
      *
      *  The data-flow engine traverses the supplied control flow graph, runs the transfer function at each vertex, and merges
@@ -278,7 +290,12 @@ public:
      *  InstructionSemantics2::BaseSemantics::State::merge "merge" method.
      *
      *  The control flow graph and transfer function are specified in the engine's constructor.  The starting CFG vertex and
-     *  its initial state are supplied when the engine starts to run. */
+     *  its initial state are supplied when the engine starts to run.
+     *
+     *  The order in which pending vertices are visited is controlled by the @ref workListOrder property. Visiting them in
+     *  reverse post-order processes each vertex after its forward-edge predecessors and usually needs far fewer iterations to
+     *  reach a fixed point when the CFG has loops.  The @ref nThreads property optionally lets @ref runToFixedPoint solve
+     *  independent strongly connected components of the CFG concurrently. */
     template<class CFG, class State, class TransferFunction, class MergeFunction>
     class Engine {
     public:
@@ -291,10 +308,42 @@ public:
         VertexStates incomingState_;                    // incoming data-flow state per CFG vertex ID
         VertexStates outgoingState_;                    // outgoing data-flow state per CFG vertex ID
         typedef Sawyer::Container::DistinctList<size_t> WorkList;
-        WorkList workList_;                             // CFG vertex IDs to be visited, last in first out w/out duplicates
+        WorkList workList_;                             // CFG vertex IDs to be visited in insertion order w/out duplicates
+        std::set<size_t> rpoWorkList_;                  // reverse post-order numbers of vertices to be visited
+        std::vector<size_t> rpoNumber_;                 // reverse post-order number per vertex ID; empty if not computed
+        std::vector<size_t> rpoVertex_;                 // vertex ID per reverse post-order number
+        WorkListOrder workListOrder_;                   // order in which to visit pending vertices
+        size_t nThreads_;                               // number of threads for runToFixedPoint; zero means hardware
         size_t maxIterations_;                          // max number of iterations to allow
         size_t nIterations_;                            // number of iterations since last reset
 
+        // Bookkeeping shared by the threads solving strongly connected components in parallel.
+        struct ParallelState {
+            static const size_t nLocks = 64;
+            boost::mutex mutex;                         // protects the following data members
+            size_t nIterations;                         // iterations performed by all threads
+            bool failed;                                // set when some thread failed; others stop early
+            bool notConverging;                         // whether the failure was a NotConverging exception
+            std::string error;                          // error message for the failure
+            boost::mutex mergeLocks[nLocks];            // protects states and pending flags of vertices by vertex ID
+            std::vector<char> pending;                  // per vertex ID, whether the vertex needs to be visited
+            std::vector<size_t> component;              // per vertex ID, the strongly connected component ID
+            std::vector<std::vector<size_t> > members;  // per component ID, the vertex IDs in that component
+
+            ParallelState(): nIterations(0), failed(false), notConverging(false) {}
+        };
+
+        // Functor invoked by worker threads to solve one strongly connected component.
+        class ComponentSolver {
+            Engine *engine_;
+            ParallelState *state_;
+        public:
+            ComponentSolver(Engine *engine, ParallelState *state): engine_(engine), state_(state) {}
+            void operator()(size_t /*taskId*/, size_t componentId) {
+                engine_->solveComponent(*state_, componentId);
+            }
+        };
+
     public:
         /** Constructor.
          *
@@ -302,7 +351,8 @@ public:
          *  transfer function.  The control flow graph is incorporated into the engine by reference; the transfer functor is
          *  copied. */
         Engine(const CFG &cfg, TransferFunction &xfer, MergeFunction merge = MergeFunction())
-            : cfg_(cfg), xfer_(xfer), merge_(merge), maxIterations_(-1), nIterations_(0) {}
+            : cfg_(cfg), xfer_(xfer), merge_(merge), workListOrder_(INSERTION_ORDER), nThreads_(1), maxIterations_(-1),
+              nIterations_(0) {}
 
         /** Data-flow control flow graph.
          *
@@ -320,9 +370,57 @@ public:
             outgoingState_.clear();
             outgoingState_.resize(cfg_.nVertices(), initialState);
             workList_.clear();
+            rpoWorkList_.clear();
+            rpoNumber_.clear();
+            rpoVertex_.clear();
             nIterations_ = 0;
         }
 
+        /** Property: Order in which pending vertices are visited.
+         *
+         *  When set to @ref INSERTION_ORDER (the default), vertices are visited in the order they were added to the work
+         *  list. When set to @ref REVERSE_POSTORDER, the engine always visits the pending vertex that comes first in a reverse
+         *  post-order of the CFG, which is computed from the first starting vertex when the first starting vertex is inserted
+         *  after a @ref reset.  Changing the order moves any pending vertices to the new work list.
+         *
+         * @{ */
+        WorkListOrder workListOrder() const { return workListOrder_; }
+        void workListOrder(WorkListOrder order) {
+            if (order != workListOrder_) {
+                std::vector<size_t> pending;
+                while (!workListIsEmpty())
+                    pending.push_back(popWork());
+                workListOrder_ = order;
+                BOOST_FOREACH (size_t vertexId, pending)
+                    pushWork(vertexId);
+            }
+        }
+        /** @} */
+
+        /** Property: Number of threads used by runToFixedPoint.
+         *
+         *  If this is one (the default) then @ref runToFixedPoint calls @ref runOneIteration until the work list is
+         *  empty. Otherwise the CFG is partitioned into strongly connected components and up to this many threads solve
+         *  components concurrently, each component starting only after all components that have edges into it are finished.
+         *  Within a component the vertices are visited in reverse post-order regardless of the @ref workListOrder property.
+         *  Zero means use the hardware concurrency.
+         *
+         *  In parallel mode the transfer function and merge function are invoked concurrently from multiple threads (although
+         *  never concurrently for the same vertex) and must therefore be thread-safe. In particular, @ref SemanticsMerge (and
+         *  any merge function derived from it) is not thread-safe because it temporarily changes the current state of its RISC
+         *  operators, which are shared by all calls; setting this property to anything other than one for such an engine
+         *  fails an assertion. If any thread throws an exception then the other threads stop early and a @ref NotConverging or
+         *  @ref Exception carrying the same message is thrown after all threads have finished.
+         *
+         * @{ */
+        size_t nThreads() const { return nThreads_; }
+        void nThreads(size_t n) {
+            ASSERT_require2((1 == n || !boost::is_base_of<SemanticsMerge, MergeFunction>::value),
+                            "SemanticsMerge is not thread-safe; data-flow must use one thread");
+            nThreads_ = n;
+        }
+        /** @} */
+
         /** Max number of iterations to allow.
          *
          *  Allow N number of calls to runOneIteration.  When the limit is exceeded a @ref NotConverging exception is
@@ -344,17 +442,22 @@ public:
          *  work list is empty (before of after the iteration). */
         bool runOneIteration() {
             using namespace Diagnostics;
-            if (!workList_.isEmpty()) {
+            if (!workListIsEmpty()) {
                 if (++nIterations_ > maxIterations_) {
                     throw NotConverging("data-flow max iterations reached"
                                         " (max=" + StringUtility::numberToString(maxIterations_) + ")");
                 }
-                size_t cfgVertexId = workList_.popFront();
+                size_t cfgVertexId = popWork();
                 if (mlog[DEBUG]) {
                     mlog[DEBUG] <<"runOneIteration: vertex #" <<cfgVertexId <<"\n";
                     mlog[DEBUG] <<"  remaining worklist is {";
-                    BOOST_FOREACH (size_t id, workList_.items())
-                        mlog[DEBUG] <<" " <<id;
+                    if (REVERSE_POSTORDER == workListOrder_) {
+                        BOOST_FOREACH (size_t rpo, rpoWorkList_)
+                            mlog[DEBUG] <<" " <<rpoVertex_[rpo];
+                    } else {
+                        BOOST_FOREACH (size_t id, workList_.items())
+                            mlog[DEBUG] <<" " <<id;
+                    }
                     mlog[DEBUG] <<" }\n";
                 }
                 
@@ -386,28 +489,34 @@ public:
                                         <<StringUtility::prefixLines(xfer_.printState(incomingState_[nextVertexId]),
                                                                      "      ", false) <<"\n";
                         }
-                        workList_.pushBack(nextVertexId);
+                        pushWork(nextVertexId);
                     } else {
                         SAWYER_MESG(mlog[DEBUG]) <<"    merged with vertex #" <<nextVertexId <<" (no change)\n";
                     }
                 }
             }
-            return !workList_.isEmpty();
+            return !workListIsEmpty();
         }
 
         /** Add a starting vertex. */
         void insertStartingVertex(size_t startVertexId, const State &initialState) {
             incomingState_[startVertexId] = initialState;
-            workList_.pushBack(startVertexId);
+            if (rpoNumber_.empty())
+                computeReversePostOrder(startVertexId);
+            pushWork(startVertexId);
         }
 
         /** Run data-flow until it reaches a fixed point.
          *
          *  Run data-flow starting at the specified control flow vertex with the specified initial state until the state
          *  converges to a fixed point or the maximum number of iterations is reached (in which case a @ref NotConverging
-         *  exception is thrown). */
+         *  exception is thrown).  See the @ref nThreads property for running in parallel. */
         void runToFixedPoint() {
-            while (runOneIteration()) /*void*/;
+            if (nThreads_ != 1) {
+                runInParallel();
+            } else {
+                while (runOneIteration()) /*void*/;
+            }
         }
 
         /** Add starting point and run to fixed point.
@@ -416,7 +525,7 @@ public:
         void runToFixedPoint(size_t startVertexId, const State &initialState) {
             reset();
             insertStartingVertex(startVertexId, initialState);
-            while (runOneIteration()) /*void*/;
+            runToFixedPoint();
         }
 
         /** Return the incoming state for the specified CFG vertex.
@@ -455,6 +564,230 @@ public:
         const VertexStates& getFinalStates() const {
             return outgoingState_;
         }
+
+    private:
+        bool workListIsEmpty() const {
+            return REVERSE_POSTORDER == workListOrder_ ? rpoWorkList_.empty() : workList_.isEmpty();
+        }
+
+        void pushWork(size_t vertexId) {
+            if (REVERSE_POSTORDER == workListOrder_) {
+                if (rpoNumber_.empty())
+                    computeReversePostOrder(vertexId);
+                rpoWorkList_.insert(rpoNumber_[vertexId]);
+            } else {
+                workList_.pushBack(vertexId);
+            }
+        }
+
+        size_t popWork() {
+            if (REVERSE_POSTORDER == workListOrder_) {
+                ASSERT_forbid(rpoWorkList_.empty());
+                size_t vertexId = rpoVertex_[*rpoWorkList_.begin()];
+                rpoWorkList_.erase(rpoWorkList_.begin());
+                return vertexId;
+            } else {
+                return workList_.popFront();
+            }
+        }
+
+        // Number the vertices in reverse post-order of a depth-first forward traversal. The traversal starts at the specified
+        // root, then continues from vertices that have no incoming edges, then from any vertices not yet reached.
+        void computeReversePostOrder(size_t rootId) {
+            typedef std::pair<typename CFG::ConstVertexIterator, typename CFG::ConstEdgeIterator> Frame;
+            size_t nVertices = cfg_.nVertices();
+            std::vector<bool> seen(nVertices, false);
+            std::vector<size_t> postOrder;
+            postOrder.reserve(nVertices);
+            std::vector<Frame> stack;
+
+            std::vector<size_t> roots(1, rootId);
+            BOOST_FOREACH (const typename CFG::Vertex &vertex, cfg_.vertices()) {
+                if (0 == vertex.nInEdges())
+                    roots.push_back(vertex.id());
+            }
+            for (size_t i=0; i<nVertices; ++i)
+                roots.push_back(i);
+
+            BOOST_FOREACH (size_t root, roots) {
+                if (seen[root])
+                    continue;
+                seen[root] = true;
+                typename CFG::ConstVertexIterator vertex = cfg_.findVertex(root);
+                stack.push_back(Frame(vertex, vertex->outEdges().begin()));
+                while (!stack.empty()) {
+                    Frame &frame = stack.back();
+                    if (frame.second != frame.first->outEdges().end()) {
+                        typename CFG::ConstVertexIterator target = frame.second->target();
+                        ++frame.second;
+                        if (!seen[target->id()]) {
+                            seen[target->id()] = true;
+                            stack.push_back(Frame(target, target->outEdges().begin()));
+                        }
+                    } else {
+                        postOrder.push_back(frame.first->id());
+                        stack.pop_back();
+                    }
+                }
+            }
+
+            ASSERT_require(postOrder.size() == nVertices);
+            rpoNumber_.resize(nVertices);
+            rpoVertex_.resize(nVertices);
+            for (size_t i=0; i<nVertices; ++i) {
+                rpoVertex_[i] = postOrder[nVertices-1-i];
+                rpoNumber_[rpoVertex_[i]] = i;
+            }
+        }
+
+        // Find the strongly connected components of the CFG using an iterative version of Tarjan's algorithm.
+        void computeComponents(ParallelState &ps) {
+            typedef std::pair<typename CFG::ConstVertexIterator, typename CFG::ConstEdgeIterator> Frame;
+            static const size_t UNVISITED = size_t(-1);
+            size_t nVertices = cfg_.nVertices();
+            std::vector<size_t> index(nVertices, UNVISITED), lowLink(nVertices, 0);
+            std::vector<bool> onStack(nVertices, false);
+            std::vector<size_t> sccStack;
+            std::vector<Frame> callStack;
+            size_t nextIndex = 0;
+
+            ps.component.resize(nVertices);
+            ps.members.clear();
+            for (size_t root=0; root<nVertices; ++root) {
+                if (index[root] != UNVISITED)
+                    continue;
+                typename CFG::ConstVertexIterator vertex = cfg_.findVertex(root);
+                index[root] = lowLink[root] = nextIndex++;
+                sccStack.push_back(root);
+                onStack[root] = true;
+                callStack.push_back(Frame(vertex, vertex->outEdges().begin()));
+                while (!callStack.empty()) {
+                    Frame &frame = callStack.back();
+                    size_t v = frame.first->id();
+                    if (frame.second != frame.first->outEdges().end()) {
+                        typename CFG::ConstVertexIterator target = frame.second->target();
+                        size_t w = target->id();
+                        ++frame.second;
+                        if (index[w] == UNVISITED) {
+                            index[w] = lowLink[w] = nextIndex++;
+                            sccStack.push_back(w);
+                            onStack[w] = true;
+                            callStack.push_back(Frame(target, target->outEdges().begin()));
+                        } else if (onStack[w]) {
+                            lowLink[v] = std::min(lowLink[v], index[w]);
+                        }
+                    } else {
+                        callStack.pop_back();
+                        if (lowLink[v] == index[v]) {
+                            size_t componentId = ps.members.size();
+                            ps.members.push_back(std::vector<size_t>());
+                            while (true) {
+                                size_t w = sccStack.back();
+                                sccStack.pop_back();
+                                onStack[w] = false;
+                                ps.component[w] = componentId;
+                                ps.members.back().push_back(w);
+                                if (w == v)
+                                    break;
+                            }
+                        }
+                        if (!callStack.empty()) {
+                            size_t u = callStack.back().first->id();
+                            lowLink[u] = std::min(lowLink[u], lowLink[v]);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Solve all strongly connected components that have pending vertices, using multiple threads.
+        void runInParallel() {
+            if (workListIsEmpty())
+                return;
+            ParallelState ps;
+            ps.nIterations = nIterations_;
+            ps.pending.resize(cfg_.nVertices(), 0);
+            while (!workListIsEmpty())
+                ps.pending[popWork()] = 1;
+            if (rpoNumber_.empty()) {
+                size_t root = 0;
+                while (!ps.pending[root])
+                    ++root;
+                computeReversePostOrder(root);
+            }
+            computeComponents(ps);
+
+            // An edge from component A to component B in the dependency graph means that A cannot start until B is finished.
+            typedef Sawyer::Container::Graph<size_t> Dependencies;
+            Dependencies dependencies;
+            for (size_t i=0; i<ps.members.size(); ++i)
+                dependencies.insertVertex(i);
+            std::set<std::pair<size_t, size_t> > seenEdges;
+            BOOST_FOREACH (const typename CFG::Edge &edge, cfg_.edges()) {
+                size_t a = ps.component[edge.target()->id()], b = ps.component[edge.source()->id()];
+                if (a != b && seenEdges.insert(std::make_pair(a, b)).second)
+                    dependencies.insertEdge(dependencies.findVertex(a), dependencies.findVertex(b));
+            }
+
+            Sawyer::workInParallel(dependencies, nThreads_, ComponentSolver(this, &ps));
+            nIterations_ = ps.nIterations;
+            if (ps.failed) {
+                if (ps.notConverging)
+                    throw NotConverging(ps.error);
+                throw Exception(ps.error);
+            }
+        }
+
+        // Run one strongly connected component to a local fixed point. All components with edges into this one have finished,
+        // so only this thread reads or writes the states of this component's vertices. States of vertices in other components
+        // are updated under a lock since several components might be feeding the same successor concurrently.
+        void solveComponent(ParallelState &ps, size_t componentId) {
+            try {
+                std::set<size_t> work;                  // reverse post-order numbers of vertices to visit
+                BOOST_FOREACH (size_t vertexId, ps.members[componentId]) {
+                    if (ps.pending[vertexId])
+                        work.insert(rpoNumber_[vertexId]);
+                }
+                while (!work.empty()) {
+                    {
+                        boost::lock_guard<boost::mutex> lock(ps.mutex);
+                        if (ps.failed)
+                            return;
+                        if (++ps.nIterations > maxIterations_) {
+                            throw NotConverging("data-flow max iterations reached"
+                                                " (max=" + StringUtility::numberToString(maxIterations_) + ")");
+                        }
+                    }
+                    size_t cfgVertexId = rpoVertex_[*work.begin()];
+                    work.erase(work.begin());
+                    typename CFG::ConstVertexIterator vertex = cfg_.findVertex(cfgVertexId);
+                    State state = outgoingState_[cfgVertexId] = xfer_(cfg_, cfgVertexId, incomingState_[cfgVertexId]);
+                    BOOST_FOREACH (const typename CFG::Edge &edge, vertex->outEdges()) {
+                        size_t nextVertexId = edge.target()->id();
+                        if (ps.component[nextVertexId] == componentId) {
+                            if (merge_(incomingState_[nextVertexId], state))
+                                work.insert(rpoNumber_[nextVertexId]);
+                        } else {
+                            boost::lock_guard<boost::mutex> lock(ps.mergeLocks[nextVertexId % ParallelState::nLocks]);
+                            if (merge_(incomingState_[nextVertexId], state))
+                                ps.pending[nextVertexId] = 1;
+                        }
+                    }
+                }
+            } catch (const NotConverging &e) {
+                boost::lock_guard<boost::mutex> lock(ps.mutex);
+                if (!ps.failed) {
+                    ps.failed = ps.notConverging = true;
+                    ps.error = e.what();
+                }
+            } catch (const std::exception &e) {
+                boost::lock_guard<boost::mutex> lock(ps.mutex);
+                if (!ps.failed) {
+                    ps.failed = true;
+                    ps.error = e.what();
+                }
+            }
+        }
     };
 };
 
@@ -58,6 +58,11 @@ namespace BinaryAnalysis {
  *  the user can use rose::BinaryAnalysis::ControlFlow::Graph, BinaryAnalysis::Dominance::Graph, or any other Boost graph
  *  satisfying these requirements.
  *
+ *  A Sawyer::Container::CsrGraph snapshot of a Sawyer graph whose vertex values are SgAsmBlock pointers also satisfies these
+ *  requirements, except that post dominance must be given an explicit stop vertex since a snapshot cannot be modified to add
+ *  a temporary unique exit vertex.  Its contiguous adjacency arrays make the iterative data-flow passes faster on large
+ *  graphs.
+ *
  *  @code
  *  // The AST traversal.
  *  struct CalculateDominance: public AstSimpleProcessing {
@@ -31,11 +31,38 @@ public:
         std::vector<SymbolicExpr::Ptr> postConditions;  /**< Additional constraints to be satisifed at the end of a path. */
         std::vector<rose_addr_t> summarizeFunctions;    /**< Functions to always summarize. */
         bool nonAddressIsFeasible;                      /**< Indeterminate/undiscovered vertices are feasible? */
+        size_t nThreads;                                /**< Number of search threads; zero means hardware concurrency. */
+        bool deterministicSearch;                       /**< Multi-threaded results independent of scheduling? */
 
         /** Default settings. */
         Settings()
             : searchMode(SEARCH_SINGLE_DFS), vertexVisitLimit((size_t)-1), maxPathLength((size_t)-1), maxCallDepth((size_t)-1),
-              maxRecursionDepth((size_t)-1), nonAddressIsFeasible(true) {}
+              maxRecursionDepth((size_t)-1), nonAddressIsFeasible(true), nThreads(1), deterministicSearch(false) {}
+    };
+
+    /** Statistics about path searching.
+     *
+     *  A path is counted as explored each time its feasibility is checked. Since the search extends paths one vertex at a
+     *  time, each prefix of a path is a separate explored path. */
+    struct Statistics {
+        size_t nPathsExplored;                          /**< Number of paths whose feasibility was checked. */
+        size_t nPathsPruned;                            /**< Number of paths abandoned without finding a feasible end. */
+        size_t nPathsSolved;                            /**< Number of feasible paths found that reach an end vertex. */
+        double elapsedTime;                             /**< Total wall clock seconds spent searching. */
+
+        Statistics()
+            : nPathsExplored(0), nPathsPruned(0), nPathsSolved(0), elapsedTime(0.0) {}
+
+        /** Rates per second of elapsed search time.
+         *
+         * @{ */
+        double exploredPerSecond() const { return elapsedTime > 0.0 ? nPathsExplored / elapsedTime : 0.0; }
+        double prunedPerSecond() const { return elapsedTime > 0.0 ? nPathsPruned / elapsedTime : 0.0; }
+        double solvedPerSecond() const { return elapsedTime > 0.0 ? nPathsSolved / elapsedTime : 0.0; }
+        /** @} */
+
+        /** Accumulate counts from another statistics object. */
+        Statistics& operator+=(const Statistics&);
     };
 
     /** Diagnostic output. */
@@ -76,6 +103,13 @@ public:
         };
 
         virtual ~PathProcessor() {}
+
+        /** Called for each feasible path.
+         *
+         *  When the search is multi-threaded (see @ref Settings::nThreads) calls are serialized, but they may come from any
+         *  thread and the @p path, @p pathConditions, CPU, and @p solver are only valid for the duration of the call. Other
+         *  threads continue searching during the call and may add vertices and edges to the paths graph, so the processor
+         *  should use the @p path rather than traverse the paths graph. */
         virtual Action found(const FeasiblePath &analyzer, const Partitioner2::CfgPath &path,
                              const std::vector<SymbolicExpr::Ptr> &pathConditions,
                              const InstructionSemantics2::BaseSemantics::DispatcherPtr&,
@@ -116,6 +150,7 @@ private:
     Partitioner2::CfgConstVertexSet pathsEndVertices_;  // vertices of paths_ where searching stops
     Partitioner2::CfgConstEdgeSet cfgAvoidEdges_;       // CFG edges to avoid
     Partitioner2::CfgConstVertexSet cfgEndAvoidVertices_;// CFG end-of-path and other avoidance vertices
+    Statistics stats_;                                  // accumulated search statistics
 
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -140,6 +175,7 @@ public:
         pathsEndVertices_.clear();
         cfgAvoidEdges_.clear();
         cfgEndAvoidVertices_.clear();
+        stats_ = Statistics();
     }
 
     /** Initialize diagnostic output. This is called automatically when ROSE is initialized. */
@@ -295,9 +331,24 @@ public:
     /** Find all feasible paths.
      *
      *  Searches for paths and calls the @p pathProcessor each time a feasible path is found. The space explored using a depth
-     *  first search, and the search can be limited with various @ref settings. */
+     *  first search, and the search can be limited with various @ref settings.
+     *
+     *  If @ref Settings::nThreads is other than one, then path prefixes are explored concurrently. Each thread builds its own
+     *  virtual CPU for each path and has its own SMT solver. Function calls are still inlined or summarized the first time a
+     *  path reaches a call site, but paths that become unreachable are not erased from the paths graph. By default threads
+     *  steal work from one another, so the order in which feasible paths are reported (and which path first reaches a call
+     *  site) depends on scheduling.  If @ref Settings::deterministicSearch is set, then prefixes are instead checked in
+     *  fixed-size batches taken from the top of a single depth-first stack and the results are processed in stack order, which
+     *  gives the same results in the same order regardless of the number of threads, including one thread. */
     void depthFirstSearch(PathProcessor &pathProcessor);
 
+    /** Statistics accumulated by all searches since the last reset.
+     *
+     * @{ */
+    const Statistics& statistics() const { return stats_; }
+    void resetStatistics() { stats_ = Statistics(); }
+    /** @} */
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Functions for getting the results
@@ -330,6 +381,9 @@ public:
     //                                  Private supporting functions
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 private:
+    struct ParallelSearch;
+    struct PrefixStatus;
+
     static rose_addr_t virtualAddress(const Partitioner2::ControlFlowGraph::ConstVertexIterator &vertex);
 
     void insertCallSummary(const Partitioner2::ControlFlowGraph::ConstVertexIterator &pathsCallSite,
@@ -337,6 +391,12 @@ private:
                            const Partitioner2::ControlFlowGraph::ConstEdgeIterator &cfgCallEdge);
 
     boost::filesystem::path emitPathGraph(size_t callId, size_t graphId);  // emit paths graph to "rose-debug" directory
+
+    // Multi-threaded searching. See depthFirstSearch.
+    void parallelSearch(PathProcessor&);
+    void evaluatePrefix(const Partitioner2::CfgPath&, SMTSolver&, PrefixStatus&);
+    void expandCallSite(ParallelSearch&, const Partitioner2::CfgPath&);
+    std::vector<Partitioner2::ControlFlowGraph::ConstEdgeIterator> nextEdges(ParallelSearch&, const Partitioner2::CfgPath&);
 };
 
 } // namespace
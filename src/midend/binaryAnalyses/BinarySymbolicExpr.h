@@ -217,6 +217,7 @@ protected:
     std::string comment_;             /**< Optional comment. Only for debugging; not significant for any calculation. */
     Hash hashval_;                    /**< Optional hash used as a quick way to indicate that two expressions are different. */
     boost::any userData_;             /**< Additional user-specified data. This is not part of the hash. */
+    bool shared_;                     /**< Node is shared by the intern table or simplification cache. Not serialized. */
 
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 private:
@@ -253,10 +254,17 @@ public:
     static const unsigned BOTTOM         = 0x00000004;
 
 protected:
+    // Nodes are marked as shared when they're added to the intern table or the simplification cache.
+    friend Ptr intern(const Ptr&);
+    friend class Interior;
+
     Node()
-        : nBits_(0), domainWidth_(0), flags_(0), hashval_(0) {}
+        : nBits_(0), domainWidth_(0), flags_(0), hashval_(0), shared_(false) {}
     explicit Node(const std::string &comment, unsigned flags=0)
-        : nBits_(0), domainWidth_(0), flags_(flags), comment_(comment), hashval_(0) {}
+        : nBits_(0), domainWidth_(0), flags_(flags), comment_(comment), hashval_(0), shared_(false) {}
+
+    // Copy of this node that is not shared.
+    Ptr unsharedCopy();
 
 public:
     /** Returns true if two expressions must be equal (cannot be unequal).
@@ -310,6 +318,15 @@ public:
      *  @ref isEquivalentTo predicate. The @p from and @p to expressions must have the same width. */
     virtual Ptr substitute(const Ptr &from, const Ptr &to) = 0;
 
+    /** Rename variables to canonical names.
+     *
+     *  Returns a new expression in which every free variable and memory state has been replaced by one whose name ID is
+     *  obtained from @p index. Names that are not yet present in @p index are assigned the next unused number (the size of the
+     *  index) in the order they're encountered during a depth-first traversal, so that two expressions that differ only in the
+     *  names of their variables produce identical results (and therefore identical hashes) when renamed with initially empty
+     *  indexes.  If no renaming is necessary then the original expression is returned. */
+    virtual Ptr renameVariables(RenameMap &index) = 0;
+
     /** Returns true if the expression is a known numeric value.
      *
      *  The value itself is stored in the @ref number property. */
@@ -338,11 +355,23 @@ public:
      *  expressions. Changing the comment property is allowed even though nodes are generally immutable because comments are
      *  not considered significant for comparisons, computing hash values, etc.
      *
+     *  The comment of a node that is shared by the intern table or the simplification cache (see @ref isShared) cannot be
+     *  changed since that would change it for unrelated expressions; use @ref newComment instead.
+     *
      * @{ */
     const std::string& comment() { return comment_; }
-    void comment(const std::string &s) { comment_ = s; }
+    void comment(const std::string &s) {
+        ASSERT_forbid2(shared_, "comment of a shared node cannot be changed; use newComment");
+        comment_ = s;
+    }
     /** @} */
 
+    /** Sets the comment of a possibly shared node.
+     *
+     *  If the node is shared by the intern table or the simplification cache (see @ref isShared) then a copy of the node that
+     *  has the new comment is returned, otherwise the comment of this node is changed and this node is returned. */
+    Ptr newComment(const std::string &s);
+
     // [Robb P. Matzke 2015-10-08]: deprecated
     const std::string& get_comment() ROSE_DEPRECATED("use 'comment' property instead") {
         return comment();
@@ -357,10 +386,12 @@ public:
      *
      *  User defined data is always optional and does not contribute to the hash value of an expression. The user-defined data
      *  can be changed at any time by the user even if the expression node to which it is attached is shared between many
-     *  expressions.
+     *  expressions, except when the node is shared by the intern table or the simplification cache (see @ref isShared); use
+     *  @ref newUserData for such nodes.
      *
      * @{ */
     void userData(boost::any &data) {
+        ASSERT_forbid2(shared_, "user data of a shared node cannot be changed; use newUserData");
         userData_ = data;
     }
     const boost::any& userData() {
@@ -368,6 +399,17 @@ public:
     }
     /** @} */
 
+    /** Sets the user-defined data of a possibly shared node.
+     *
+     *  Works like @ref newComment, but for the user-defined data. */
+    Ptr newUserData(const boost::any &data);
+
+    /** Whether this node is shared by the intern table or the simplification cache.
+     *
+     *  Such a node might be returned for any equivalent expression that's constructed later, therefore its comment and
+     *  user-defined data cannot be modified in place. See @ref internExpressions and @ref memoizeSimplifications. */
+    bool isShared() { return shared_; }
+
     /** Property: Number of significant bits.
      *
      *  An expression with a known value is guaranteed to have all higher-order bits cleared. */
@@ -775,6 +817,7 @@ public:
     virtual bool isEquivalentTo(const Ptr &other) ROSE_OVERRIDE;
     virtual int compareStructure(const Ptr& other) ROSE_OVERRIDE;
     virtual Ptr substitute(const Ptr &from, const Ptr &to) ROSE_OVERRIDE;
+    virtual Ptr renameVariables(RenameMap &index) ROSE_OVERRIDE;
     virtual bool isNumber() ROSE_OVERRIDE {
         return false; /*if it's known, then it would have been folded to a leaf*/
     }
@@ -811,7 +854,9 @@ public:
         return getOperator();
     }
 
-    /** Simplifies the specified interior node. Returns a new node if necessary, otherwise returns this. */
+    /** Simplifies the specified interior node. Returns a new node if necessary, otherwise returns this. If expression interning
+     *  is enabled then the result is the interned equivalent node; see @ref internExpressions. Results are memoized when @ref
+     *  memoizeSimplifications is enabled. */
     Ptr simplifyTop();
 
     /** Perform constant folding.  This method returns either a new expression (if changes were mde) or the original
@@ -879,6 +924,10 @@ protected:
     /** Adjust user-defined bit flags. This must only be called from constructors.  Flags are the union of the operand flags
      *  subject to simplification rules, unioned with the specified flags. */
     void adjustBitFlags(unsigned extraFlags);
+
+private:
+    // Runs the simplifiers without consulting the simplification cache.
+    Ptr simplifyTopUncached();
 };
 
 
@@ -1001,6 +1050,7 @@ public:
     virtual bool isEquivalentTo(const Ptr &other) ROSE_OVERRIDE;
     virtual int compareStructure(const Ptr& other) ROSE_OVERRIDE;
     virtual Ptr substitute(const Ptr &from, const Ptr &to) ROSE_OVERRIDE;
+    virtual Ptr renameVariables(RenameMap &index) ROSE_OVERRIDE;
     virtual VisitAction depthFirstTraversal(Visitor&) ROSE_OVERRIDE;
     virtual uint64_t nNodes() ROSE_OVERRIDE { return 1; }
 
@@ -1072,6 +1122,135 @@ private:
     static uint64_t nextNameCounter(uint64_t useThis = (uint64_t)(-1));
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Interning
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Statistics about expression interning.
+ *
+ *  @sa internStatistics */
+struct InternStatistics {
+    size_t nLookups;                                    /**< Number of nodes presented to the intern table. */
+    size_t nHits;                                       /**< Number of lookups that found an existing equivalent node. */
+    size_t nReclaimed;                                  /**< Number of unreferenced nodes removed from the table. */
+    size_t size;                                        /**< Number of nodes currently in the table. */
+
+    InternStatistics()
+        : nLookups(0), nHits(0), nReclaimed(0), size(0) {}
+};
+
+/** Property: Whether new expressions are interned.
+ *
+ *  When interning is enabled, every node returned by the @ref Leaf and @ref Interior factory methods (and therefore the
+ *  "make" functions) is looked up in a global table and, if an equivalent node already exists, that existing node is returned
+ *  instead of the new one (hash consing).  Two nodes are considered equal for this purpose if they are structurally
+ *  equivalent according to @ref Node::isEquivalentTo, have the same domain width, and have the same comment.  As a result,
+ *  expressions constructed while interning is enabled share all their common subtrees, and equal expressions are usually
+ *  the same pointer.  Since an interned node can be returned for unrelated expressions, its comment and user data cannot be
+ *  changed in place (see @ref Node::isShared); @ref Node::newComment and @ref Node::newUserData return a modified copy
+ *  instead.  Attributes are not protected this way and changes to them are visible through every expression that contains
+ *  the node.
+ *
+ *  The table is thread safe. It is divided into independently locked shards selected by the expression hash so that threads
+ *  constructing unrelated expressions seldom contend.  The table holds a reference to each node, and nodes that are referenced
+ *  only by the table are reclaimed automatically as the table grows, or explicitly by @ref reclaimInterned.
+ *
+ *  Interning is disabled by default. This property should be set before any threads start creating expressions. Disabling
+ *  interning does not remove nodes already in the table; use @ref clearInterned for that.
+ *
+ * @{ */
+bool internExpressions();
+void internExpressions(bool);
+/** @} */
+
+/** Returns the interned node equivalent to the specified node.
+ *
+ *  If an equivalent node is already present in the intern table then it is returned, otherwise the specified node is added to
+ *  the table and returned. This is done regardless of the @ref internExpressions property, although the expression's
+ *  subtrees are not interned by this function. */
+Ptr intern(const Ptr&);
+
+/** Remove unreferenced nodes from the intern table.
+ *
+ *  Removes all nodes whose only reference is from the intern table itself, including nodes that become unreferenced because
+ *  their parents were removed.  Returns the number of nodes removed. */
+size_t reclaimInterned();
+
+/** Remove all nodes from the intern table.
+ *
+ *  Nodes that are still referenced elsewhere continue to exist, but they will no longer be returned by future lookups. */
+void clearInterned();
+
+/** Statistics about the intern table.
+ *
+ *  Returns the statistics accumulated since the last call to @ref resetInternStatistics. The @c size member is always the
+ *  current size of the table.
+ *
+ * @{ */
+InternStatistics internStatistics();
+void resetInternStatistics();
+/** @} */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Simplification cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Statistics about memoized simplification.
+ *
+ *  @sa simplificationStatistics */
+struct SimplificationStatistics {
+    size_t nLookups;                                    /**< Number of simplifications that consulted the cache. */
+    size_t nHits;                                       /**< Number of simplifications answered by the cache. */
+    size_t nEvictions;                                  /**< Number of entries replaced by newer entries. */
+
+    SimplificationStatistics()
+        : nLookups(0), nHits(0), nEvictions(0) {}
+};
+
+/** Property: Whether simplification results are memoized.
+ *
+ *  When enabled, @ref Interior::simplifyTop remembers the result of simplifying each new interior node, keyed by the node's
+ *  operator, width, flags, comment, and operands. A later node that has the same operator, width, flags, and comment and whose
+ *  operands are the same node pointers is replaced by the remembered result without running the simplifiers again.  Operands
+ *  are compared by pointer rather than structure, so hits are most frequent when operands are shared, such as when an
+ *  expression built from the same subexpressions is recreated, or when @ref internExpressions is enabled.
+ *
+ *  The cache has a fixed number of entries (see @ref simplificationCacheSize); when a new result maps to an occupied entry the
+ *  old result is discarded.  The cache is thread safe.  Memoization is disabled by default. While it's enabled the cache holds
+ *  references to the remembered results and their operands; disabling it releases them.
+ *
+ *  A remembered result is returned to every caller whose expression matches, so results are shared more widely than without
+ *  memoization. A result becomes shared (see @ref Node::isShared) when the cache returns it to a second caller, after which
+ *  its comment and user data cannot be modified in place.
+ *
+ * @{ */
+bool memoizeSimplifications();
+void memoizeSimplifications(bool);
+/** @} */
+
+/** Property: Number of entries in the simplification cache.
+ *
+ *  Changing the size discards all cached results. The size is rounded up to a multiple of the number of locks that protect the
+ *  cache. A size of zero disables memoization regardless of the @ref memoizeSimplifications property. No memory is used for the
+ *  entries while memoization is disabled.
+ *
+ * @{ */
+size_t simplificationCacheSize();
+void simplificationCacheSize(size_t);
+/** @} */
+
+/** Discard all memoized simplification results. */
+void clearSimplificationCache();
+
+/** Statistics about the simplification cache.
+ *
+ *  Returns the statistics accumulated since the last call to @ref resetSimplificationStatistics.
+ *
+ * @{ */
+SimplificationStatistics simplificationStatistics();
+void resetSimplificationStatistics();
+/** @} */
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Factories
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -160,10 +160,16 @@ typedef boost::shared_ptr<class MemoryState> MemoryStatePtr;
 /** Byte-addressable memory.
  *
  *  This class represents an entire state of memory via MemoryMap, allocating new memory in units of pages (the size of a page
- *  is configurable. */
+ *  is configurable.
+ *
+ *  Copies of a memory state share their data buffers copy-on-write at page granularity: copying a state copies only the list
+ *  of segments, and the first write to a shared page gives the writing state its own copy of just that page (or of the part
+ *  of the page that's within the segment being written). Untouched pages remain shared among all the copies, so forking a
+ *  state costs time proportional to the number of segments rather than the amount of memory. */
 class MemoryState: public BaseSemantics::MemoryState {
     MemoryMap::Ptr map_;
     rose_addr_t pageSize_;
+    AddressIntervalSet dirtyPages_;                     // pages written since this state was created or dirtyPages cleared
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
@@ -175,13 +181,14 @@ protected:
     }
 
     MemoryState(const MemoryState &other)
-        : BaseSemantics::MemoryState(other), map_(other.map_), pageSize_(other.pageSize_) {
-        if (map_) {
+        : BaseSemantics::MemoryState(other), pageSize_(other.pageSize_) {
+        if (other.map_) {
+            map_ = other.map_->shallowCopy();
             BOOST_FOREACH (MemoryMap::Segment &segment, map_->values())
                 segment.buffer()->copyOnWrite(true);
         }
     }
-    
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Static allocating constructors
 public:
@@ -194,8 +201,9 @@ public:
 
     /** Instantiates a new deep copy of an existing state.
      *
-     *  For efficiency purposes, the data buffers are not copied immediately but rather marked as copy-on-write. However, the
-     *  newly constructed memory map will have its own segments, which hold the segment names, access permissions, etc. */
+     *  For efficiency purposes, the data buffers are not copied immediately but rather marked as copy-on-write, and pages are
+     *  copied individually when they're first written. However, the newly constructed memory map will have its own segments,
+     *  which hold the segment names, access permissions, etc. The new state has no dirty pages. */
     static MemoryStatePtr instance(const MemoryStatePtr &other) {
         return MemoryStatePtr(new MemoryState(*other));
     }
@@ -215,8 +223,9 @@ public:
     /** Virtual copy constructor.
      *
      *  Creates a new deep copy of this memory state. For efficiency purposes, the data buffers are not copied immediately but
-     *  rather marked as copy-on-write.  However, the newly constructed memory map will have its own segments, which hold the
-     *  segment names, access permissions, etc. */
+     *  rather marked as copy-on-write, and pages are copied individually when they're first written.  However, the newly
+     *  constructed memory map will have its own segments, which hold the segment names, access permissions, etc. The new
+     *  state has no dirty pages. */
     virtual BaseSemantics::MemoryStatePtr clone() const ROSE_OVERRIDE {
         return MemoryStatePtr(new MemoryState(*this));
     }
@@ -237,6 +246,7 @@ public:
 public:
     virtual void clear() ROSE_OVERRIDE {
         map_ = MemoryMap::Ptr();
+        dirtyPages_.clear();
     }
 
     virtual void print(std::ostream&, Formatter&) const ROSE_OVERRIDE;
@@ -280,6 +290,32 @@ public:
      *  is already allocated unless: it will replace the allocated page with a new one containing all zeros. */
     void allocatePage(rose_addr_t va);
 
+    /** Pages modified in this state.
+     *
+     *  Returns the addresses of all pages that have been written or allocated since this state was created (including by
+     *  copying another state) or since the dirty pages were last cleared.  Each interval is a whole number of pages. The
+     *  addresses are tracked through this class's methods; writing directly to the @ref memoryMap bypasses the tracking. */
+    const AddressIntervalSet& dirtyPages() const { return dirtyPages_; }
+
+    /** Forget which pages are dirty. */
+    void clearDirtyPages() { dirtyPages_.clear(); }
+
+    /** Pages whose contents differ between two states.
+     *
+     *  Returns the addresses of all pages that are mapped in only one of the two states, or whose bytes differ.  Pages that
+     *  are still shared copy-on-write by both states are known to be equal without comparing their bytes. The two memory maps
+     *  are walked segment by segment, and only the pages not shared by both states are compared, so comparing a state with its
+     *  ancestor or with a sibling takes time proportional to the number of segments and written pages rather than the number
+     *  of mapped pages. Each interval is a whole number of pages. Both states must have the same page size. */
+    AddressIntervalSet differences(const MemoryStatePtr &other) const;
+
+private:
+    // Give this state its own copy of the part of the page that's in the same segment as the specified address, if that
+    // segment's buffer might be shared with other states.
+    void unsharePage(rose_addr_t va);
+
+    // True if the specified page has the same contents in both maps.
+    static bool samePage(const MemoryMap::Ptr &a, const MemoryMap::Ptr &b, const AddressInterval &page);
 };
 
 
@@ -6,16 +6,30 @@
 #endif
 
 #include <BinarySymbolicExpr.h>
+#include <boost/filesystem.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/thread/mutex.hpp>
 #include <inttypes.h>
+#include <list>
+#include <map>
+#include <Sawyer/Map.h>
+#include <Sawyer/Optional.h>
+#include <Sawyer/SharedObject.h>
+#include <Sawyer/SharedPointer.h>
 
 namespace rose {
 namespace BinaryAnalysis {
 
 /** Interface to Satisfiability Modulo Theory (SMT) solvers.
  *
- *  The purpose of an SMT solver is to determine if an expression is satisfiable. */
+ *  The purpose of an SMT solver is to determine if an expression is satisfiable.
+ *
+ *  Solvers can be used in two ways.  The @ref satisfiable methods answer one self-contained question each time they're
+ *  called, usually by running the solver as a separate process with a generated input file.  Alternatively, a solver that
+ *  supports incremental sessions can be started once with @ref session_start, after which assertions are added with @ref
+ *  insert, checked with @ref check, and retracted in groups with @ref push and @ref pop.  A session communicates with one
+ *  long-lived solver process over pipes, so extending or retracting a set of assertions costs only the text for the
+ *  assertions that changed. */
 class SMTSolver {
 public:
     struct Exception {
@@ -32,17 +46,141 @@ public:
 
     /** SMT solver statistics. */
     struct Stats {
-        Stats(): ncalls(0), input_size(0), output_size(0) {}
-        size_t ncalls;                          /**< Number of times satisfiable() was called. */
-        size_t input_size;                      /**< Bytes of input generated for satisfiable(). */
+        Stats()
+            : ncalls(0), input_size(0), output_size(0), ncache_hits(0), ncache_misses(0), nsessions(0), session_time(0.0) {}
+        size_t ncalls;                          /**< Number of times satisfiable() or check() invoked the SMT solver. */
+        size_t input_size;                      /**< Bytes of input generated for the SMT solver. */
         size_t output_size;                     /**< Amount of output produced by the SMT solver. */
+        size_t ncache_hits;                     /**< Number of satisfiable() calls answered by the query cache. */
+        size_t ncache_misses;                   /**< Number of satisfiable() calls not found in the query cache. */
+        size_t nsessions;                       /**< Number of incremental sessions started. */
+        double session_time;                    /**< Elapsed seconds during which incremental sessions were running. */
     };
 
     typedef std::set<uint64_t> Definitions;     /**< Free variables that have been defined. */
 
+    /** Cache of satisfiability results.
+     *
+     *  A cache maps a set of assertions to the result previously returned by an SMT solver along with any evidence of
+     *  satisfiability.  Assertions are normalized before lookup by renaming their variables to canonical names (see @ref
+     *  SymbolicExpr::Node::renameVariables), so queries that differ only in the names of their free variables share a single
+     *  entry.  The key is the canonical text of the renamed assertions (see @ref SMTSolver::cache_lookup), which is compared
+     *  in full, so distinct queries never share an entry.  Evidence is stored in terms of the canonical variable names and
+     *  translated back to the caller's names when the entry is used.
+     *
+     *  At most @ref maxSize entries are kept in memory; the least recently used entries are discarded first.
+     *
+     *  If a directory is specified then entries are also stored on disk, one file per query, and entries written by other
+     *  processes using the same directory are visible to this cache.  Each file contains the text of its query, which is
+     *  compared when the file is read.  Files are written to a temporary name and then renamed so that readers never see
+     *  partial entries.  Files are never removed by the cache; the size of the directory is up to the user.
+     *
+     *  Results of @ref SAT_UNKNOWN are never cached. All methods are thread safe. */
+    class Cache: public Sawyer::SharedObject {
+    public:
+        /** Shared-ownership pointer to a cache. See @ref heap_object_shared_ownership. */
+        typedef Sawyer::SharedPointer<Cache> Ptr;
+
+        /** Evidence stored in a cache entry, indexed by canonical variable name or memory address. */
+        typedef Sawyer::Container::Map<std::string, Sawyer::Container::BitVector> Evidence;
+
+        /** Information stored for one query. */
+        struct Entry {
+            Satisfiable sat;                    /**< Result returned by the solver. */
+            Evidence evidence;                  /**< Evidence of satisfiability in terms of canonical names. */
+
+            Entry(): sat(SAT_UNKNOWN) {}
+        };
+
+        /** Default for the @ref maxSize property. */
+        static const size_t DEFAULT_MAX_SIZE = 100000;
+
+    private:
+        // Queries in order of use, most recent first. The strings are the keys of entries_.
+        typedef std::list<const std::string*> UseOrder;
+
+        struct Slot {
+            Entry entry;
+            UseOrder::iterator use;
+        };
+
+        typedef std::map<std::string, Slot> Entries;
+
+        mutable boost::mutex mutex_;            // protects all following data members
+        Entries entries_;
+        UseOrder useOrder_;
+        size_t maxSize_;
+        boost::filesystem::path directory_;
+
+    protected:
+        Cache()
+            : maxSize_(DEFAULT_MAX_SIZE) {}
+
+        explicit Cache(const boost::filesystem::path &directory)
+            : maxSize_(DEFAULT_MAX_SIZE), directory_(directory) {}
+
+    public:
+        /** Allocating constructor.
+         *
+         *  Creates a new, empty cache. If a directory is specified then the cache is also backed by files in that directory,
+         *  which is created if necessary.
+         *
+         * @{ */
+        static Ptr instance() {
+            return Ptr(new Cache);
+        }
+        static Ptr instance(const boost::filesystem::path &directory);
+        /** @} */
+
+        /** Property: Directory for persistent storage.
+         *
+         *  An empty path means that the cache is stored only in memory. */
+        boost::filesystem::path directory() const;
+
+        /** Property: Maximum number of entries stored in memory.
+         *
+         *  When an insertion would exceed this limit, the least recently used entries are removed from memory. Entries stored
+         *  on disk are not affected. The limit must be positive.
+         *
+         * @{ */
+        size_t maxSize() const;
+        void maxSize(size_t);
+        /** @} */
+
+        /** Number of entries stored in memory. */
+        size_t size() const;
+
+        /** Remove all entries from memory.  Entries stored on disk are not affected. */
+        void clear();
+
+        /** Look up an entry.
+         *
+         *  Returns the entry for the specified canonical query if one exists in memory or on disk. Entries found on disk are
+         *  also added to the in-memory cache. */
+        Sawyer::Optional<Entry> find(const std::string &query);
+
+        /** Insert an entry.
+         *
+         *  Inserts or replaces the entry for the specified canonical query in memory and, if a directory was specified, on
+         *  disk. Entries whose result is @ref SAT_UNKNOWN are ignored. */
+        void insert(const std::string &query, const Entry&);
+
+    private:
+        void insertInMemory(const std::string &query, const Entry&); // caller must hold mutex_
+        void evict();                           // caller must hold mutex_
+        boost::filesystem::path entryFileName(const std::string &query) const;
+        Sawyer::Optional<Entry> readEntry(const std::string &query) const;
+        void writeEntry(const std::string &query, const Entry&) const;
+    };
+
 private:
+    struct Session;                             // state for an incremental session; defined in SMTSolver.C
+
     std::string name_;
     FILE *debug;
+    Cache::Ptr cache_;
+    Session *session_;                          // non-null while an incremental session is active; not copied
+    Stats session_stats_;                       // statistics for the current or most recent session
     void init();
 
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
@@ -56,9 +194,26 @@ private:
 #endif
 
 public:
-    SMTSolver(): debug(NULL) { init(); }
+    SMTSolver(): debug(NULL), session_(NULL) { init(); }
+
+    // Copies do not share the original's incremental session, if any.
+    SMTSolver(const SMTSolver &other)
+        : name_(other.name_), debug(other.debug), cache_(other.cache_), session_(NULL), output_text(other.output_text),
+          stats(other.stats) {}
+
+    SMTSolver& operator=(const SMTSolver &other) {
+        if (this != &other) {
+            session_end();
+            name_ = other.name_;
+            debug = other.debug;
+            cache_ = other.cache_;
+            output_text = other.output_text;
+            stats = other.stats;
+        }
+        return *this;
+    }
 
-    virtual ~SMTSolver() {}
+    virtual ~SMTSolver();
 
     /** Property: Name of solver for debugging.
      *
@@ -70,6 +225,26 @@ public:
     /** Create a solver by name. */
     SMTSolver* instance(const std::string &name);
 
+    /** Property: Query cache.
+     *
+     *  If non-null, the @ref satisfiable methods consult this cache before invoking the solver and store the solver's answer
+     *  in the cache afterward.  A cache may be shared by any number of solvers, including solvers in different threads.
+     *  The property is initialized from @ref defaultCache when a solver is constructed.
+     *
+     * @{ */
+    Cache::Ptr cache() const { return cache_; }
+    void cache(const Cache::Ptr &c) { cache_ = c; }
+    /** @} */
+
+    /** Property: Default query cache.
+     *
+     *  This is the cache assigned to each newly constructed solver. The default is null, which disables caching.
+     *
+     * @{ */
+    static Cache::Ptr defaultCache();
+    static void defaultCache(const Cache::Ptr&);
+    /** @} */
+
     /** Determines if expressions are trivially satisfiable or unsatisfiable.  If all expressions are known 1-bit values that
      *  are true, then this function returns SAT_YES.  If any expression is a known 1-bit value that is false, then this
      *  function returns SAT_NO.  Otherwise this function returns SAT_UNKNOWN. */
@@ -84,6 +259,57 @@ public:
 
 
 
+    /** Start an incremental session.
+     *
+     *  Launches the solver as a long-lived child process that reads commands from a pipe.  The session initially has no
+     *  assertions and no pushed levels.  Throws an @ref Exception if a session is already active or if this solver does not
+     *  support incremental sessions (see @ref get_session_command). */
+    void session_start();
+
+    /** End the incremental session.
+     *
+     *  Terminates the solver process and adds the session's elapsed time to the statistics. This is a no-op if no session is
+     *  active.  Sessions are also ended by the destructor. */
+    void session_end();
+
+    /** True if an incremental session is active. */
+    bool in_session() const { return session_ != NULL; }
+
+    /** Push a new assertion level.
+     *
+     *  Assertions made after this call are discarded by the matching @ref pop, and so are variable definitions if the solver
+     *  scopes them (see @ref get_pop_retracts_definitions). */
+    void push();
+
+    /** Pop an assertion level.
+     *
+     *  Discards all assertions made since the most recent @ref push, and the variable definitions made since then if the
+     *  solver scopes them. Variables whose definitions were discarded are defined again when they're next used. Throws an
+     *  @ref Exception if there is no pushed level. */
+    void pop();
+
+    /** Number of levels pushed in the current session. */
+    size_t n_levels() const;
+
+    /** Add an assertion to the current level.
+     *
+     *  The expression must be a Boolean (one-bit) expression. Variables that have not yet been defined in the session are
+     *  defined at the current level.
+     *
+     * @{ */
+    void insert(const SymbolicExpr::Ptr&);
+    void insert(const std::vector<SymbolicExpr::Ptr>&);
+    /** @} */
+
+    /** Check satisfiability of the session's assertions.
+     *
+     *  Determines whether the conjunction of all assertions at all levels is satisfiable.  If so, evidence of satisfiability
+     *  is available through the usual evidence methods until the next call. */
+    Satisfiable check();
+
+    /** Statistics for the current or most recent incremental session. */
+    Stats get_session_stats() const;
+
     /** Evidence of satisfiability for a bitvector variable.  If an expression is satisfiable, this function will return
      *  a value for the specified bitvector variable that satisfies the expression in conjunction with the other evidence. Not
      *  all SMT solvers can return this information.  Returns the null pointer if no evidence is available for the variable.
@@ -150,16 +376,90 @@ protected:
      *  of stdout emitted by the solver should be the word "sat" or "unsat". */
     virtual std::string get_command(const std::string &config_name) = 0;
 
+    /** Command that runs the solver for an incremental session.  The solver must read commands from its standard input and
+     *  write responses to its standard output.  An empty string (the default) means sessions are not supported. */
+    virtual std::string get_session_command() { return ""; }
+
+    /** Whether popping a session level discards the variable definitions made at that level.  This is true for SMT-LIB2
+     *  solvers. Solvers whose definitions are global must return false so that variables are not defined twice. */
+    virtual bool get_pop_retracts_definitions() { return true; }
+
+    /** Generates input that is sent to the solver once at the start of a session. */
+    virtual void generate_session_prologue(std::ostream&) {}
+
+    /** Generates input that asserts one expression in a session. Any variables not already present in the definitions are
+     *  defined and added to the definitions. */
+    virtual void generate_assertion(std::ostream&, const SymbolicExpr::Ptr&, Definitions*) {
+        throw Exception("incremental sessions are not supported by " + name());
+    }
+
+    /** Generates input that pushes or pops one assertion level in a session.
+     *
+     * @{ */
+    virtual void generate_push(std::ostream&) {
+        throw Exception("incremental sessions are not supported by " + name());
+    }
+    virtual void generate_pop(std::ostream&) {
+        throw Exception("incremental sessions are not supported by " + name());
+    }
+    /** @} */
+
+    /** Generates input that asks the solver to check satisfiability in a session. The solver's response should be a line
+     *  containing the word "sat", "unsat", or "unknown". */
+    virtual void generate_check(std::ostream&) {
+        throw Exception("incremental sessions are not supported by " + name());
+    }
+
+    /** Generates input that asks the solver for evidence after a session check returned "sat". Solvers that report evidence
+     *  without being asked don't need to generate anything. */
+    virtual void generate_evidence_request(std::ostream&) {}
+
+    /** Generates input that causes the solver to echo the specified string on a line of its own. This is used to find the
+     *  end of variable-length responses in a session. */
+    virtual void generate_echo(std::ostream&, const std::string&) {
+        throw Exception("incremental sessions are not supported by " + name());
+    }
+
     /** Parses evidence of satisfiability.  Some solvers can emit information about what variable bindings satisfy the
      *  expression.  This information is parsed by this function and added to a mapping of variable to value. */
     virtual void parse_evidence() {};
 
+    /** Adds one item of evidence.  This is used to restore evidence from the query cache. The name is a variable name or
+     *  memory address as described for @ref evidence_for_name and the value is a constant. Solvers that don't support
+     *  evidence can ignore this. */
+    virtual void add_evidence(const std::string &/*name*/, const SymbolicExpr::Ptr &/*value*/) {}
+
+    /** Look up a query in the cache.
+     *
+     *  If this solver has a cache and the cache contains the answer for the specified assertions, then the cached evidence (if
+     *  any) is restored and the cached result is returned.  Otherwise @ref SAT_UNKNOWN is returned and the canonical query
+     *  text (the cache key) and variable renaming map are returned through the pointer arguments so they can later be passed
+     *  to @ref cache_result.
+     *
+     *  The canonical text has one line per distinct node of the renamed assertions, children before their parents, in which
+     *  an interior node refers to its children by line number; its size is therefore linear in the number of distinct nodes
+     *  even when the assertions share subexpressions. */
+    Satisfiable cache_lookup(const std::vector<SymbolicExpr::Ptr> &exprs, std::string *query /*out*/,
+                             SymbolicExpr::RenameMap *index /*out*/);
+
+    /** Store a solver result in the cache.  The key and index must be those computed by @ref cache_lookup. Evidence is
+     *  obtained from @ref evidence_names and @ref evidence_for_name. */
+    void cache_result(const std::string &query, const SymbolicExpr::RenameMap &index, Satisfiable);
+
+private:
+    // Send input to the session's solver process, or read one line of its output.
+    void session_send(const std::string&);
+    std::string session_receive();
+    void session_require() const;
+
+protected:
     /** Additional output obtained by satisfiable(). */
     std::string output_text;
 
     // Statistics
     static boost::mutex class_stats_mutex;
     static Stats class_stats;                   // all access must be protected by class_stats_mutex
+    static Cache::Ptr default_cache;            // all access must be protected by class_stats_mutex
     Stats stats;
 };
 
@@ -0,0 +1,114 @@
+#ifndef Rose_SmtlibSolver_H
+#define Rose_SmtlibSolver_H
+
+#include "SMTSolver.h"
+#include <boost/filesystem.hpp>
+#include <Sawyer/Map.h>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Interface to solvers that speak SMT-LIB version 2.
+ *
+ *  This is a generic wrapper around any solver executable that accepts SMT-LIB2 input in the QF_ABV logic (quantifier-free
+ *  bit vectors and arrays), such as Z3, CVC4, Boolector, or Yices2.  Symbolic expressions are translated so that every term,
+ *  including Boolean terms, is a bit vector; one-bit vectors are used for Booleans.  Memory states are arrays indexed by
+ *  address.
+ *
+ *  The @ref satisfiable methods write an input file and run the executable with that file as its final argument. Incremental
+ *  sessions (see @ref SMTSolver::session_start) run the executable with the session arguments and communicate over pipes using
+ *  SMT-LIB2 "push" and "pop" commands.
+ *
+ *  Evidence of satisfiability is available for bit vector variables but not for memory. */
+class SmtlibSolver: public SMTSolver {
+private:
+    typedef Sawyer::Container::Map<SymbolicExpr::Ptr, std::string> TermNames;
+    typedef std::map<std::string/*name*/, std::pair<size_t/*nbits*/, uint64_t/*value*/> > Evidence;
+
+    boost::filesystem::path executable_;
+    std::string shellArgs_;
+    std::string sessionArgs_;
+    TermNames termNames_;
+    size_t nCses_;
+    Evidence evidence_;
+
+public:
+    /** Construct a solver for the specified executable.
+     *
+     *  The @p shellArgs are inserted into every command line after the executable name, and the @p sessionArgs are added after
+     *  those when starting an incremental session in order to cause the solver to read commands from its standard input.  The
+     *  defaults are appropriate for Z3. */
+    explicit SmtlibSolver(const std::string &name, const boost::filesystem::path &executable,
+                          const std::string &shellArgs = "-smt2", const std::string &sessionArgs = "-in")
+        : executable_(executable), shellArgs_(shellArgs), sessionArgs_(sessionArgs), nCses_(0) {
+        this->name(name);
+    }
+
+    /** Property: Name of solver executable.
+     *
+     * @{ */
+    const boost::filesystem::path& executable() const { return executable_; }
+    void executable(const boost::filesystem::path &p) { executable_ = p; }
+    /** @} */
+
+    /** Property: Arguments inserted after the executable name.
+     *
+     * @{ */
+    const std::string& shellArgs() const { return shellArgs_; }
+    void shellArgs(const std::string &s) { shellArgs_ = s; }
+    /** @} */
+
+    /** Property: Additional arguments that cause the executable to read commands from standard input.
+     *
+     * @{ */
+    const std::string& sessionArgs() const { return sessionArgs_; }
+    void sessionArgs(const std::string &s) { sessionArgs_ = s; }
+    /** @} */
+
+    virtual SymbolicExpr::Ptr evidence_for_name(const std::string&) /*overrides*/;
+    virtual std::vector<std::string> evidence_names() /*overrides*/;
+    virtual void clear_evidence() /*overrides*/;
+
+protected:
+    virtual void generate_file(std::ostream&, const std::vector<SymbolicExpr::Ptr> &exprs, Definitions*) /*overrides*/;
+    virtual std::string get_command(const std::string &config_name) /*overrides*/;
+    virtual void parse_evidence() /*overrides*/;
+    virtual void add_evidence(const std::string &name, const SymbolicExpr::Ptr &value) /*overrides*/;
+    virtual std::string get_session_command() /*overrides*/;
+    virtual void generate_session_prologue(std::ostream&) /*overrides*/;
+    virtual void generate_assertion(std::ostream&, const SymbolicExpr::Ptr&, Definitions*) /*overrides*/;
+    virtual void generate_push(std::ostream&) /*overrides*/;
+    virtual void generate_pop(std::ostream&) /*overrides*/;
+    virtual void generate_check(std::ostream&) /*overrides*/;
+    virtual void generate_evidence_request(std::ostream&) /*overrides*/;
+    virtual void generate_echo(std::ostream&, const std::string&) /*overrides*/;
+
+private:
+    static std::string typeName(const SymbolicExpr::Ptr&);
+
+    // These out*() functions convert a SymbolicExpr expression into SMT-LIB2 text.
+    void outDefinitions(std::ostream&, const std::vector<SymbolicExpr::Ptr>&, Definitions*);
+    void outCommonSubexpressions(std::ostream&, const std::vector<SymbolicExpr::Ptr>&);
+    void outAssertion(std::ostream&, const SymbolicExpr::Ptr&);
+    void outExpression(std::ostream&, const SymbolicExpr::Ptr&);
+    void outConstant(std::ostream&, const SymbolicExpr::LeafPtr&);
+    void outUnary(std::ostream&, const char *opname, const SymbolicExpr::InteriorPtr&);
+    void outLeftAssociative(std::ostream&, const char *opname, const SymbolicExpr::InteriorPtr&);
+    void outPredicate(std::ostream&, const char *opname, const SymbolicExpr::InteriorPtr&, bool negate=false);
+    void outIte(std::ostream&, const SymbolicExpr::InteriorPtr&);
+    void outExtract(std::ostream&, const SymbolicExpr::InteriorPtr&);
+    void outExtend(std::ostream&, const char *opname, const SymbolicExpr::InteriorPtr&);
+    void outResize(std::ostream&, const SymbolicExpr::Ptr&, size_t newWidth, bool isSigned);
+    void outShift(std::ostream&, const char *opname, const SymbolicExpr::InteriorPtr&, bool newbits);
+    void outRotate(std::ostream&, const char *opname, const SymbolicExpr::InteriorPtr&);
+    void outZerop(std::ostream&, const SymbolicExpr::InteriorPtr&);
+    void outMultiply(std::ostream&, const SymbolicExpr::InteriorPtr&, bool isSigned);
+    void outDivide(std::ostream&, const char *opname, const SymbolicExpr::InteriorPtr&, bool isSigned);
+    void outRead(std::ostream&, const SymbolicExpr::InteriorPtr&);
+    void outWrite(std::ostream&, const SymbolicExpr::InteriorPtr&);
+};
+
+} // namespace
+} // namespace
+
+#endif
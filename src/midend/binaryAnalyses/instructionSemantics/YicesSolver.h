@@ -22,6 +22,9 @@ namespace BinaryAnalysis {
  *
  *  Yices provides two interfaces: an executable named "yices", and a library. The choice of which linkage to use to answer
  *  satisfiability questions is made at runtime (see set_linkage()).
+ *
+ *  Incremental sessions (see @ref SMTSolver::session_start) always use the "yices" executable regardless of the linkage
+ *  property, and are therefore available only if ROSE was configured with the location of that executable.
  */
 class YicesSolver: public SMTSolver {
 public:
@@ -41,6 +44,7 @@ protected:
 private:
     LinkMode linkage;
     TermNames termNames;                                // only used by Yices executable translator; library uses termExprs
+    size_t nCses;                                       // number of common subexpression names defined; not serialized
 #ifdef ROSE_HAVE_LIBYICES
     yices_context context;
 #else
@@ -65,7 +69,7 @@ private:
 
 public:
     /** Constructor prefers to use the Yices executable interface. See set_linkage(). */
-    YicesSolver(): linkage(LM_NONE), context(NULL) {
+    YicesSolver(): linkage(LM_NONE), nCses(0), context(NULL) {
         init();
     }
     virtual ~YicesSolver();
@@ -107,6 +111,14 @@ public:
 protected:
     virtual uint64_t parse_variable(const char *nptr, char **endptr, char first_char);
     virtual void parse_evidence();
+    virtual void add_evidence(const std::string &name, const SymbolicExpr::Ptr &value) /*overrides*/;
+    virtual std::string get_session_command() /*overrides*/;
+    virtual bool get_pop_retracts_definitions() /*overrides*/;
+    virtual void generate_assertion(std::ostream&, const SymbolicExpr::Ptr&, Definitions*) /*overrides*/;
+    virtual void generate_push(std::ostream&) /*overrides*/;
+    virtual void generate_pop(std::ostream&) /*overrides*/;
+    virtual void generate_check(std::ostream&) /*overrides*/;
+    virtual void generate_echo(std::ostream&, const std::string&) /*overrides*/;
 
 private:
     void init();
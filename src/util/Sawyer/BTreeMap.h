@@ -0,0 +1,688 @@
+// WARNING: Changes to this file must be contributed back to Sawyer or else they will
+//          be clobbered by the next update from Sawyer.  The Sawyer repository is at
+//          https://github.com/matzke1/sawyer.
+
+
+
+
+#ifndef Sawyer_BTreeMap_H
+#define Sawyer_BTreeMap_H
+
+#include <Sawyer/Assert.h>
+#include <Sawyer/Optional.h>
+#include <Sawyer/Sawyer.h>
+#include <algorithm>
+#include <boost/range/iterator_range.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <vector>
+
+namespace Sawyer {
+namespace Container {
+
+/** %Container associating values with keys, stored in contiguous leaf blocks.
+ *
+ *  This container has the same interface as @ref Map for the operations that it supports, but is organized as a B+-tree
+ *  whose leaves are arrays of up to @p LeafSize key/value pairs stored contiguously in key order.  The leaves are indexed by
+ *  a single sorted array holding the greatest key of each leaf, which plays the role of the B+-tree's interior nodes.  A
+ *  search is therefore a binary search of the index followed by a binary search of one leaf, both over contiguous memory,
+ *  and iteration proceeds through each leaf sequentially.  Inserting or erasing a node moves at most @p LeafSize nodes, and
+ *  only when a leaf overflows or becomes sparse do the index and leaf pointer arrays need to be adjusted.
+ *
+ *  Compared to @ref Map (a red-black tree with one allocation per node), this container makes far fewer allocations and
+ *  has much better locality for large numbers of nodes.  Compared to @ref FlatMap, insertion and erasure in the middle of
+ *  the container are much cheaper at a small cost in search speed.
+ *
+ *  Unlike @ref Map, all iterators are invalidated by any operation that inserts or erases nodes. */
+template<class K,
+         class T,
+         class Cmp = std::less<K>,
+         size_t LeafSize = 64>
+class BTreeMap {
+public:
+    typedef K Key;                                      /**< Type for keys. */
+    typedef T Value;                                    /**< Type for values associated with each key. */
+    typedef Cmp Comparator;                             /**< Type of comparator, third template argument. */
+
+    /** Type for stored nodes.
+     *
+     *  A storage node contains the immutable key and its associated value. */
+    class Node {
+        Key key_;
+        Value value_;
+    public:
+        Node(const Key &key, const Value &value): key_(key), value_(value) {}
+
+        /** Key part of key/value node.
+         *
+         *  Returns the key part of a key/value node. Keys are not mutable when they are part of a map. */
+        const Key& key() const { return key_; }
+
+        /** Value part of key/value node.
+         *
+         *  Returns a reference to the value part of a key/value node.
+         *
+         * @{ */
+        Value& value() { return value_; }
+        const Value& value() const { return value_; }
+        /** @} */
+    };
+
+private:
+    typedef std::vector<Node> Leaf;                     // nodes sorted by key; never empty while part of the tree
+    typedef std::vector<Leaf*> Leaves;                  // leaves sorted by key
+
+    // Compares nodes with keys so that the standard binary searches can operate directly on a leaf.
+    class NodeKeyCompare {
+        Comparator cmp_;
+    public:
+        explicit NodeKeyCompare(const Comparator &cmp): cmp_(cmp) {}
+        bool operator()(const Node &node, const Key &key) const { return cmp_(node.key(), key); }
+        bool operator()(const Key &key, const Node &node) const { return cmp_(key, node.key()); }
+    };
+
+    // Position of a node. The end position is one past the last node of the last leaf, or (0,0) when there are no leaves.
+    class Cursor {
+        const Leaves *leaves_;
+        size_t leaf_, slot_;
+    public:
+        Cursor(): leaves_(NULL), leaf_(0), slot_(0) {}
+        Cursor(const Leaves *leaves, size_t leaf, size_t slot): leaves_(leaves), leaf_(leaf), slot_(slot) {}
+        size_t leaf() const { return leaf_; }
+        size_t slot() const { return slot_; }
+        Node& node() const { return (*(*leaves_)[leaf_])[slot_]; }
+        Cursor& operator++() {
+            if (++slot_ >= (*leaves_)[leaf_]->size() && leaf_ + 1 < leaves_->size()) {
+                ++leaf_;
+                slot_ = 0;
+            }
+            return *this;
+        }
+        Cursor& operator--() {
+            if (0 == slot_) {
+                --leaf_;
+                slot_ = (*leaves_)[leaf_]->size() - 1;
+            } else {
+                --slot_;
+            }
+            return *this;
+        }
+        bool operator==(const Cursor &other) const { return leaf_ == other.leaf_ && slot_ == other.slot_; }
+        bool operator!=(const Cursor &other) const { return leaf_ != other.leaf_ || slot_ != other.slot_; }
+    };
+
+    Leaves leaves_;
+    std::vector<Key> greatest_;                         // greatest key of each leaf; parallel to leaves_
+    size_t size_;                                       // total number of nodes
+    Comparator comparator_;
+
+private:
+    friend class boost::serialization::access;
+
+    template<class S>
+    void save(S &s, const unsigned /*version*/) const {
+        size_t n = size_;
+        s <<BOOST_SERIALIZATION_NVP(n);
+        for (ConstNodeIterator iter=nodes().begin(); iter!=nodes().end(); ++iter) {
+            s <<boost::serialization::make_nvp("key", iter->key());
+            s <<boost::serialization::make_nvp("value", iter->value());
+        }
+    }
+
+    template<class S>
+    void load(S &s, const unsigned /*version*/) {
+        clear();
+        size_t n = 0;
+        s >>BOOST_SERIALIZATION_NVP(n);
+        for (size_t i=0; i<n; ++i) {
+            Key key;
+            Value value;
+            s >>BOOST_SERIALIZATION_NVP(key);
+            s >>BOOST_SERIALIZATION_NVP(value);
+            insert(key, value);                         // saved in sorted order, so each insert appends
+        }
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Iterators
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+private:
+    template<class Derived, class Value, class BaseIterator>
+    class BidirectionalIterator: public std::iterator<std::bidirectional_iterator_tag, Value> {
+    protected:
+        BaseIterator base_;
+        BidirectionalIterator() {}
+        BidirectionalIterator(const BaseIterator &base): base_(base) {}
+    public:
+        Derived& operator=(const Derived &other) { base_ = other.base_; return *derived(); }
+        Derived& operator++() { ++base_; return *derived(); }
+        Derived operator++(int) { Derived old=*derived(); ++*this; return old; }
+        Derived& operator--() { --base_; return *derived(); }
+        Derived operator--(int) { Derived old=*derived(); --*this; return old; }
+        template<class OtherIter> bool operator==(const OtherIter &other) const { return base_ == other.base(); }
+        template<class OtherIter> bool operator!=(const OtherIter &other) const { return base_ != other.base(); }
+        const BaseIterator& base() const { return base_; }
+    protected:
+        Derived* derived() { return static_cast<Derived*>(this); }
+        const Derived* derived() const { return static_cast<const Derived*>(this); }
+    };
+
+public:
+    /** Bidirectional iterator over key/value nodes.
+     *
+     *  Dereferencing this iterator will return a Node from which both the key and the value can be obtained. Node iterators
+     *  are implicitly convertible to both key and value iterators. */
+    class NodeIterator: public BidirectionalIterator<NodeIterator, Node, Cursor> {
+        typedef                BidirectionalIterator<NodeIterator, Node, Cursor> Super;
+    public:
+        NodeIterator() {}
+        NodeIterator(const NodeIterator &other): Super(other) {}
+        Node& operator*() const { return this->base_.node(); }
+        Node* operator->() const { return &this->base_.node(); }
+    private:
+        friend class BTreeMap;
+        NodeIterator(const Cursor &base): Super(base) {}
+    };
+
+    /** Bidirectional iterator over key/value nodes.
+     *
+     *  Dereferencing this iterator will return a Node from which both the key and the value can be obtained. Node iterators
+     *  are implicitly convertible to both key and value iterators. */
+    class ConstNodeIterator: public BidirectionalIterator<ConstNodeIterator, const Node, Cursor> {
+        typedef                     BidirectionalIterator<ConstNodeIterator, const Node, Cursor> Super;
+    public:
+        ConstNodeIterator() {}
+        ConstNodeIterator(const ConstNodeIterator &other): Super(other) {}
+        ConstNodeIterator(const NodeIterator &other): Super(other.base()) {}
+        const Node& operator*() const { return this->base_.node(); }
+        const Node* operator->() const { return &this->base_.node(); }
+    private:
+        friend class BTreeMap;
+        ConstNodeIterator(const Cursor &base): Super(base) {}
+    };
+
+    /** Bidirectional iterator over keys.
+     *
+     *  Dereferencing this iterator will return a reference to a const key.  Keys cannot be altered while they are a member of
+     *  this container. */
+    class ConstKeyIterator: public BidirectionalIterator<ConstKeyIterator, const Key, Cursor> {
+        typedef                    BidirectionalIterator<ConstKeyIterator, const Key, Cursor> Super;
+    public:
+        ConstKeyIterator() {}
+        ConstKeyIterator(const ConstKeyIterator &other): Super(other) {}
+        ConstKeyIterator(const NodeIterator &other): Super(other.base()) {}
+        ConstKeyIterator(const ConstNodeIterator &other): Super(other.base()) {}
+        const Key& operator*() const { return this->base_.node().key(); }
+        const Key* operator->() const { return &this->base_.node().key(); }
+    };
+
+    /** Bidirectional iterator over values.
+     *
+     *  Dereferencing this iterator will return a reference to the user-defined value of the node.  Values may be altered
+     *  in-place while they are members of a container. */
+    class ValueIterator: public BidirectionalIterator<ValueIterator, Value, Cursor> {
+        typedef                 BidirectionalIterator<ValueIterator, Value, Cursor> Super;
+    public:
+        ValueIterator() {}
+        ValueIterator(const ValueIterator &other): Super(other) {}
+        ValueIterator(const NodeIterator &other): Super(other.base()) {}
+        Value& operator*() const { return this->base_.node().value(); }
+        Value* operator->() const { return &this->base_.node().value(); }
+    };
+
+    /** Bidirectional iterator over values.
+     *
+     *  Dereferencing this iterator will return a reference to the user-defined value of the node.  Values may be altered
+     *  in-place while they are members of a container. */
+    class ConstValueIterator: public BidirectionalIterator<ConstValueIterator, const Value, Cursor> {
+        typedef BidirectionalIterator<ConstValueIterator, const Value, Cursor> Super;
+    public:
+        ConstValueIterator() {}
+        ConstValueIterator(const ConstValueIterator &other): Super(other) {}
+        ConstValueIterator(const ValueIterator &other): Super(other.base()) {}
+        ConstValueIterator(const ConstNodeIterator &other): Super(other.base()) {}
+        ConstValueIterator(const NodeIterator &other): Super(other.base()) {}
+        const Value& operator*() const { return this->base_.node().value(); }
+        const Value* operator->() const { return &this->base_.node().value(); }
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Default constructor.
+     *
+     *  Creates an empty map. */
+    BTreeMap(): size_(0) {}
+
+    /** Constructs an empty map.
+     *
+     *  This is like the default constructor, but a comparer can be specified. */
+    explicit BTreeMap(const Comparator &comparator)
+        : size_(0), comparator_(comparator) {}
+
+    /** Copy constructor. */
+    BTreeMap(const BTreeMap &other)
+        : size_(0), comparator_(other.comparator_) {
+        copyLeaves(other);
+    }
+
+    /** Copy constructor.
+     *
+     *  Initializes the new map with copies of the nodes of the @p other map, which can be any container having the @ref Map
+     *  interface.  The keys and values must be convertible from the other map to this map. */
+    template<class OtherMap>
+    explicit BTreeMap(const OtherMap &other)
+        : size_(0) {
+        insertMultiple(other.nodes());
+    }
+
+    ~BTreeMap() {
+        clear();
+    }
+
+    /** Make this map be a copy of another map. */
+    BTreeMap& operator=(const BTreeMap &other) {
+        if (this != &other) {
+            clear();
+            comparator_ = other.comparator_;
+            copyLeaves(other);
+        }
+        return *this;
+    }
+
+    /** Make this map be a copy of another map.
+     *
+     *  The keys and values of the @p other map must be convertible to the types used for this map. */
+    template<class OtherMap>
+    BTreeMap& operator=(const OtherMap &other) {
+        clear();
+        insertMultiple(other.nodes());
+        return *this;
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Iteration
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Iterators for container nodes.
+     *
+     *  This returns a range of node-iterators that will traverse all nodes (key/value pairs) of this container.
+     *
+     * @{ */
+    boost::iterator_range<NodeIterator> nodes() {
+        return boost::iterator_range<NodeIterator>(NodeIterator(beginCursor()), NodeIterator(endCursor()));
+    }
+    boost::iterator_range<ConstNodeIterator> nodes() const {
+        return boost::iterator_range<ConstNodeIterator>(ConstNodeIterator(beginCursor()), ConstNodeIterator(endCursor()));
+    }
+    /** @} */
+
+    /** Iterators for container keys.
+     *
+     *  Returns a range of key-iterators that will traverse the keys of this container.
+     *
+     * @{ */
+    boost::iterator_range<ConstKeyIterator> keys() {
+        return boost::iterator_range<ConstKeyIterator>(NodeIterator(beginCursor()), NodeIterator(endCursor()));
+    }
+    boost::iterator_range<ConstKeyIterator> keys() const {
+        return boost::iterator_range<ConstKeyIterator>(ConstNodeIterator(beginCursor()), ConstNodeIterator(endCursor()));
+    }
+    /** @} */
+
+    /** Iterators for container values.
+     *
+     *  Returns a range of iterators that will traverse the user-defined values of this container.  The values are iterated in
+     *  key order, although the keys are not directly available via these iterators.
+     *
+     * @{ */
+    boost::iterator_range<ValueIterator> values() {
+        return boost::iterator_range<ValueIterator>(NodeIterator(beginCursor()), NodeIterator(endCursor()));
+    }
+    boost::iterator_range<ConstValueIterator> values() const {
+        return boost::iterator_range<ConstValueIterator>(ConstNodeIterator(beginCursor()), ConstNodeIterator(endCursor()));
+    }
+    /** @} */
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Size and capacity
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Determines whether this container is empty.
+     *
+     *  Returns true if the container is empty, and false if it has at least one node. This method executes in constant time. */
+    bool isEmpty() const {
+        return 0 == size_;
+    }
+
+    /** Number of nodes, keys, or values in this container.
+     *
+     *  Returns the number of nodes currently in this container. This method executes in constant time. */
+    size_t size() const {
+        return size_;
+    }
+
+    /** Number of leaves.
+     *
+     *  Returns the number of contiguous leaf blocks used to store the nodes. This is mostly for debugging and tuning. */
+    size_t nLeaves() const {
+        return leaves_.size();
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Searching
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Find a node by key.
+     *
+     *  Looks for a node whose key is equal to the specified @p key and returns an iterator to that node, or the end iterator
+     *  if no such node exists.  Two keys are considered equal if this container's @ref Comparator object returns false
+     *  reflexively. The method executes in logorithmic time based on the number of nodes in the container.
+     *
+     * @{ */
+    NodeIterator find(const Key &key) {
+        Cursor lb = lowerBoundCursor(key);
+        return lb==endCursor() || comparator_(key, lb.node().key()) ? NodeIterator(endCursor()) : NodeIterator(lb);
+    }
+    ConstNodeIterator find(const Key &key) const {
+        Cursor lb = lowerBoundCursor(key);
+        return lb==endCursor() || comparator_(key, lb.node().key()) ? ConstNodeIterator(endCursor()) : ConstNodeIterator(lb);
+    }
+    /** @} */
+
+    /** Determine if a key exists.
+     *
+     *  Looks for a node whose key is equal to the specified @p key and returns true if found, or false if no such node
+     *  exists. */
+    bool exists(const Key &key) const {
+        return find(key) != nodes().end();
+    }
+
+    /** Find a node close to a key.
+     *
+     *  Finds the first node whose key is not less than (i.e., greater than or equal to) the specified @p key. Returns the end
+     *  iterator if no such node exists.  This method executes in logarithmic time.
+     *
+     * @{ */
+    NodeIterator lowerBound(const Key &key) {
+        return NodeIterator(lowerBoundCursor(key));
+    }
+    ConstNodeIterator lowerBound(const Key &key) const {
+        return ConstNodeIterator(lowerBoundCursor(key));
+    }
+    /** @} */
+
+    /** Find a node close to a key.
+     *
+     *  Finds the first node whose key is greater than the specified @p key.  Returns the end iterator if no such node exists.
+     *  This method executes in logarithmic time.
+     *
+     * @{ */
+    NodeIterator upperBound(const Key &key) {
+        return NodeIterator(upperBoundCursor(key));
+    }
+    ConstNodeIterator upperBound(const Key &key) const {
+        return ConstNodeIterator(upperBoundCursor(key));
+    }
+    /** @} */
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Accessors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Lookup and return an existing value.
+     *
+     *  Returns a reference to the value associated with the specified @p key, or throws an <code>std::domain_error</code> if
+     *  the key does not exist.
+     *
+     * @{ */
+    Value& get(const Key &key) {
+        NodeIterator found = find(key);
+        if (found == nodes().end())
+            throw std::domain_error("key lookup failure; key is not in map domain");
+        return found->value();
+    }
+    const Value& get(const Key &key) const {
+        ConstNodeIterator found = find(key);
+        if (found == nodes().end())
+            throw std::domain_error("key lookup failure; key is not in map domain");
+        return found->value();
+    }
+    /** @} */
+
+    /** Lookup and return a value or nothing.
+     *
+     *  Looks up the node with the specified key and returns either a copy of its value, or nothing. */
+    Optional<Value> getOptional(const Key &key) const {
+        ConstNodeIterator found = find(key);
+        return found == nodes().end() ? Optional<Value>() : Optional<Value>(found->value());
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Mutators
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Insert or update a key/value pair.
+     *
+     *  Inserts the key/value pair into the container. If a previous node already had the same key then its value is replaced
+     *  by the new value. */
+    BTreeMap& insert(const Key &key, const Value &value) {
+        if (leaves_.empty()) {
+            leaves_.push_back(new Leaf);
+            leaves_.back()->reserve(LeafSize);
+            leaves_.back()->push_back(Node(key, value));
+            greatest_.push_back(key);
+            ++size_;
+            return *this;
+        }
+
+        // Find the leaf that should contain the key, or the last leaf if the key is greater than all existing keys.
+        size_t leafIdx = std::lower_bound(greatest_.begin(), greatest_.end(), key, comparator_) - greatest_.begin();
+        if (leafIdx == leaves_.size())
+            --leafIdx;
+        Leaf &leaf = *leaves_[leafIdx];
+        typename Leaf::iterator lb = std::lower_bound(leaf.begin(), leaf.end(), key, NodeKeyCompare(comparator_));
+        if (lb!=leaf.end() && !comparator_(key, lb->key())) {
+            lb->value() = value;
+            return *this;
+        }
+        bool isAppend = lb == leaf.end();
+        if (isAppend)
+            greatest_[leafIdx] = key;
+        leaf.insert(lb, Node(key, value));
+        ++size_;
+
+        // Split full leaves in half. When appending past the end of the last leaf (the common case when building a map in key
+        // order), leave the old leaf full instead.
+        if (leaf.size() > LeafSize) {
+            size_t splitAt = isAppend && leafIdx+1 == leaves_.size() ? leaf.size()-1 : leaf.size()/2;
+            Leaf *right = new Leaf;
+            right->reserve(LeafSize);
+            right->insert(right->end(), leaf.begin()+splitAt, leaf.end());
+            leaf.erase(leaf.begin()+splitAt, leaf.end());
+            leaves_.insert(leaves_.begin()+leafIdx+1, right);
+            greatest_.insert(greatest_.begin()+leafIdx+1, greatest_[leafIdx]);
+            greatest_[leafIdx] = leaf.back().key();
+        }
+        return *this;
+    }
+
+    /** Insert multiple values.
+     *
+     *  Inserts copies of the nodes in the specified node iterator range. The iterators must iterate over objects that have
+     *  <code>key</code> and <code>value</code> methods that return keys and values that are convertible to the types used by
+     *  this container.
+     *
+     * @{ */
+    template<class OtherNodeIterator>
+    BTreeMap& insertMultiple(const OtherNodeIterator &begin, const OtherNodeIterator &end) {
+        for (OtherNodeIterator otherIter=begin; otherIter!=end; ++otherIter)
+            insert(Key(otherIter->key()), Value(otherIter->value()));
+        return *this;
+    }
+    template<class OtherNodeIterator>
+    BTreeMap& insertMultiple(const boost::iterator_range<OtherNodeIterator> &range) {
+        return insertMultiple(range.begin(), range.end());
+    }
+    /** @} */
+
+    /** Remove all nodes.
+     *
+     *  All nodes are removed from this container. */
+    BTreeMap& clear() {
+        for (size_t i=0; i<leaves_.size(); ++i)
+            delete leaves_[i];
+        leaves_.clear();
+        greatest_.clear();
+        size_ = 0;
+        return *this;
+    }
+
+    /** Remove a node with specified key.
+     *
+     *  Removes the node whose key is equal to the specified key, or does nothing if no such node exists. */
+    BTreeMap& erase(const Key &key) {
+        NodeIterator found = find(key);
+        if (found != nodes().end())
+            eraseAt(found);
+        return *this;
+    }
+
+    /** Remove a node by iterator.
+     *
+     *  Removes the node referenced by @p iter. The iterator must reference a valid node in this container. */
+    BTreeMap& eraseAt(const NodeIterator &iter) {
+        ASSERT_require(iter != nodes().end());
+        NodeIterator next = iter;
+        ++next;
+        return eraseAtMultiple(iter, next);
+    }
+
+    /** Remove multiple nodes by iterator range.
+     *
+     *  The iterator range must contain iterators that point into this container.
+     *
+     * @{ */
+    BTreeMap& eraseAtMultiple(const NodeIterator &begin, const NodeIterator &end) {
+        const Cursor &b = begin.base(), &e = end.base();
+        if (b == e)
+            return *this;
+        if (b.leaf() == e.leaf()) {
+            Leaf &leaf = *leaves_[b.leaf()];
+            leaf.erase(leaf.begin()+b.slot(), leaf.begin()+e.slot());
+            size_ -= e.slot() - b.slot();
+            repairLeaf(b.leaf());
+        } else {
+            // Partial first leaf, whole middle leaves, and partial last leaf. The last leaf is repaired first so the index of
+            // the first leaf doesn't change.
+            Leaf &first = *leaves_[b.leaf()];
+            size_ -= first.size() - b.slot();
+            first.erase(first.begin()+b.slot(), first.end());
+            for (size_t i=b.leaf()+1; i<e.leaf(); ++i) {
+                size_ -= leaves_[i]->size();
+                delete leaves_[i];
+            }
+            leaves_.erase(leaves_.begin()+b.leaf()+1, leaves_.begin()+e.leaf());
+            greatest_.erase(greatest_.begin()+b.leaf()+1, greatest_.begin()+e.leaf());
+            Leaf &last = *leaves_[b.leaf()+1];
+            last.erase(last.begin(), last.begin()+e.slot());
+            size_ -= e.slot();
+            repairLeaf(b.leaf()+1);
+            repairLeaf(b.leaf());
+        }
+        return *this;
+    }
+    BTreeMap& eraseAtMultiple(const boost::iterator_range<NodeIterator> &range) {
+        return eraseAtMultiple(range.begin(), range.end());
+    }
+    /** @} */
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Private support methods
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+private:
+    Cursor beginCursor() const {
+        return Cursor(&leaves_, 0, 0);
+    }
+
+    Cursor endCursor() const {
+        return leaves_.empty() ? Cursor(&leaves_, 0, 0) : Cursor(&leaves_, leaves_.size()-1, leaves_.back()->size());
+    }
+
+    Cursor lowerBoundCursor(const Key &key) const {
+        size_t leafIdx = std::lower_bound(greatest_.begin(), greatest_.end(), key, comparator_) - greatest_.begin();
+        if (leafIdx == leaves_.size())
+            return endCursor();
+        const Leaf &leaf = *leaves_[leafIdx];
+        size_t slot = std::lower_bound(leaf.begin(), leaf.end(), key, NodeKeyCompare(comparator_)) - leaf.begin();
+        return Cursor(&leaves_, leafIdx, slot);
+    }
+
+    Cursor upperBoundCursor(const Key &key) const {
+        size_t leafIdx = std::upper_bound(greatest_.begin(), greatest_.end(), key, comparator_) - greatest_.begin();
+        if (leafIdx == leaves_.size())
+            return endCursor();
+        const Leaf &leaf = *leaves_[leafIdx];
+        size_t slot = std::upper_bound(leaf.begin(), leaf.end(), key, NodeKeyCompare(comparator_)) - leaf.begin();
+        return Cursor(&leaves_, leafIdx, slot);
+    }
+
+    // Restore the invariants for a leaf whose nodes were erased: empty leaves are removed, the index is updated, and sparse
+    // leaves are merged into a neighbor when the result fits in one leaf.
+    void repairLeaf(size_t leafIdx) {
+        Leaf *leaf = leaves_[leafIdx];
+        if (leaf->empty()) {
+            delete leaf;
+            leaves_.erase(leaves_.begin()+leafIdx);
+            greatest_.erase(greatest_.begin()+leafIdx);
+            return;
+        }
+        greatest_[leafIdx] = leaf->back().key();
+        if (leaf->size() < LeafSize/4) {
+            if (leafIdx+1 < leaves_.size() && leaf->size() + leaves_[leafIdx+1]->size() <= LeafSize) {
+                mergeLeaves(leafIdx);
+            } else if (leafIdx > 0 && leaf->size() + leaves_[leafIdx-1]->size() <= LeafSize) {
+                mergeLeaves(leafIdx-1);
+            }
+        }
+    }
+
+    // Append the nodes of the leaf at leafIdx+1 to the leaf at leafIdx and remove the former.
+    void mergeLeaves(size_t leafIdx) {
+        Leaf *left = leaves_[leafIdx], *right = leaves_[leafIdx+1];
+        left->insert(left->end(), right->begin(), right->end());
+        greatest_[leafIdx] = greatest_[leafIdx+1];
+        delete right;
+        leaves_.erase(leaves_.begin()+leafIdx+1);
+        greatest_.erase(greatest_.begin()+leafIdx+1);
+    }
+
+    void copyLeaves(const BTreeMap &other) {
+        leaves_.reserve(other.leaves_.size());
+        for (size_t i=0; i<other.leaves_.size(); ++i)
+            leaves_.push_back(new Leaf(*other.leaves_[i]));
+        greatest_ = other.greatest_;
+        size_ = other.size_;
+    }
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,620 @@
+// WARNING: Changes to this file must be contributed back to Sawyer or else they will
+//          be clobbered by the next update from Sawyer.  The Sawyer repository is at
+//          https://github.com/matzke1/sawyer.
+
+
+
+
+#ifndef Sawyer_CsrGraph_H
+#define Sawyer_CsrGraph_H
+
+#include <Sawyer/Assert.h>
+#include <Sawyer/Graph.h>
+#include <Sawyer/Sawyer.h>
+
+#include <boost/foreach.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <iterator>
+#include <vector>
+
+namespace Sawyer {
+namespace Container {
+
+/** Frozen compressed sparse row representation of a graph.
+ *
+ *  A CsrGraph is an immutable snapshot of a @ref Graph that stores its connectivity in a few contiguous arrays instead of the
+ *  linked lists used by @ref Graph.  The snapshot is built in linear time from an existing graph and thereafter cannot be
+ *  modified; the original graph can be modified or destroyed without affecting the snapshot.  Analyses that make many passes
+ *  over a graph that doesn't change (dominators, data-flow, path searching, isomorphism, etc.) benefit from the improved
+ *  locality, particularly on large control flow graphs.
+ *
+ *  The API is the read-only subset of the @ref Graph API, so the algorithms in @ref GraphAlgorithm.h and the traversals in
+ *  @ref GraphTraversal.h accept a CsrGraph wherever they accept a const @ref Graph. Including <Sawyer/GraphBoost.h> also
+ *  makes a CsrGraph usable as a Boost Graph Library bidirectional graph.
+ *
+ *  Vertex and edge ID numbers are the same as in the original graph, therefore any vector indexed by the original ID numbers
+ *  can be used with the snapshot and vice versa.  Vertices are stored in ID order.  Edges are stored grouped by their source
+ *  vertex, in the same order as each vertex's out-edge list in the original graph, therefore the order of @ref edges differs
+ *  from the original graph but each vertex's @ref Vertex::outEdges "outEdges" is a contiguous subrange of @ref edges.
+ *  Incoming edges are stored as a second contiguous array of pointers ordered by target vertex.
+ *
+ *  User-defined vertex and edge values are copied into the snapshot when it's constructed.
+ *
+ *  @code
+ *  typedef Sawyer::Container::Graph<std::string, int> MyGraph;
+ *  MyGraph graph = ...;
+ *  Sawyer::Container::CsrGraph<MyGraph> frozen(graph);
+ *  BOOST_FOREACH (const CsrGraph<MyGraph>::Edge &edge, frozen.findVertex(0)->outEdges())
+ *      std::cout <<edge.target()->value() <<"\n";
+ *  @endcode */
+template<class G>
+class CsrGraph {
+public:
+    typedef G OriginalGraph;                            /**< Type of graph from which the snapshot was created. */
+    typedef typename G::VertexValue VertexValue;        /**< User-level data associated with vertices. */
+    typedef typename G::EdgeValue EdgeValue;            /**< User-level data associated with edges. */
+    class Vertex;                                       /**< All information about a vertex. User info plus connectivity info. */
+    class Edge;                                         /**< All information about an edge. User info plus connectivity info. */
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Iterators
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:                                                 // public only for the sake of doxygen
+    /** Base class for edge iterators.
+     *
+     *  An edge iterator points either directly into the edge array (for the list of all edges and for out-edge lists) or into
+     *  the array of incoming edge pointers (for in-edge lists).  Iterators are equality-comparable with one another even when
+     *  they come from different lists: two iterators are equal if they point to the same edge, and all end iterators are equal
+     *  to each other. */
+    template<class Derived, class Value>
+    class EdgeBaseIterator: public std::iterator<std::bidirectional_iterator_tag, Value> {
+        const Edge *edge_;                              // current edge when iterating the edge array directly
+        const Edge *end_;                               // end of the edge array sublist
+        const Edge *const *slot_;                       // current slot when iterating in-edges; null otherwise
+    protected:
+        friend class CsrGraph;
+        EdgeBaseIterator(): edge_(NULL), end_(NULL), slot_(NULL) {}
+        EdgeBaseIterator(const Edge *edge, const Edge *end): edge_(edge), end_(end), slot_(NULL) {}
+        explicit EdgeBaseIterator(const Edge *const *slot): edge_(NULL), end_(NULL), slot_(slot) {}
+        template<class Derived2, class Value2>
+        EdgeBaseIterator(const EdgeBaseIterator<Derived2, Value2> &other)
+            : edge_(other.edge_), end_(other.end_), slot_(other.slot_) {}
+
+        // Edge to which this iterator points, or null for any end iterator. In-edge lists are terminated by a null slot.
+        const Edge* edge() const {
+            if (slot_)
+                return *slot_;
+            return edge_ == end_ ? NULL : edge_;
+        }
+
+        const Edge& dereference() const {
+            const Edge *e = edge();
+            ASSERT_not_null(e);
+            return *e;
+        }
+
+    private:
+        template<class Derived2, class Value2> friend class EdgeBaseIterator;
+        Derived* derived() { return static_cast<Derived*>(this); }
+
+    public:
+        /** Increment.
+         *
+         *  Causes this iterator to advance to the next edge of its list. This method should not be invoked on an iterator that
+         *  points to the end of the list.
+         *
+         * @{ */
+        Derived& operator++() {
+            if (slot_) {
+                ++slot_;
+            } else {
+                ++edge_;
+            }
+            return *derived();
+        }
+        Derived operator++(int) {
+            Derived old = *derived();
+            ++*this;
+            return old;
+        }
+        /** @} */
+
+        /** Decrement.
+         *
+         *  Causes this iterator to advance to the previous edge of its list. This method should not be invoked on an iterator
+         *  that points to the beginning of the list.
+         *
+         * @{ */
+        Derived& operator--() {
+            if (slot_) {
+                --slot_;
+            } else {
+                --edge_;
+            }
+            return *derived();
+        }
+        Derived operator--(int) {
+            Derived old = *derived();
+            --*this;
+            return old;
+        }
+        /** @} */
+
+        /** Equality predicate.
+         *
+         *  Two iterators are equal if they point to the same edge, regardless of which list they came from. All end iterators
+         *  are equal to one another.
+         *
+         * @{ */
+        template<class OtherIter>
+        bool operator==(const OtherIter &other) const {
+            return edge() == other.edge();
+        }
+        template<class OtherIter>
+        bool operator!=(const OtherIter &other) const {
+            return edge() != other.edge();
+        }
+        /** @} */
+
+        /** Iterator comparison. */
+        bool operator<(const EdgeBaseIterator &other) const {
+            return edge() < other.edge();
+        }
+    };
+
+    /** Base class for vertex iterators. */
+    template<class Derived, class Value>
+    class VertexBaseIterator: public std::iterator<std::bidirectional_iterator_tag, Value> {
+        const Vertex *base_;
+    protected:
+        friend class CsrGraph;
+        VertexBaseIterator(): base_(NULL) {}
+        explicit VertexBaseIterator(const Vertex *base): base_(base) {}
+        template<class Derived2, class Value2>
+        VertexBaseIterator(const VertexBaseIterator<Derived2, Value2> &other): base_(other.base_) {}
+        const Vertex& dereference() const { return *base_; }
+    private:
+        template<class Derived2, class Value2> friend class VertexBaseIterator;
+        Derived* derived() { return static_cast<Derived*>(this); }
+    public:
+        /** Increment.
+         *
+         *  Causes this iterator to advance to the next vertex. This method should not be invoked on an iterator that points to
+         *  the end of the list.
+         *
+         * @{ */
+        Derived& operator++() { ++base_; return *derived(); }
+        Derived operator++(int) { Derived old=*derived(); ++*this; return old; }
+        /** @} */
+
+        /** Decrement.
+         *
+         *  Causes this iterator to advance to the previous vertex. This method should not be invoked on an iterator that points
+         *  to the beginning of the list.
+         *
+         * @{ */
+        Derived& operator--() { --base_; return *derived(); }
+        Derived operator--(int) { Derived old=*derived(); --*this; return old; }
+        /** @} */
+
+        /** Equality predicate.
+         *
+         *  Two iterators are equal if they point to the same vertex, and unequal otherwise.
+         *
+         * @{ */
+        template<class OtherIter> bool operator==(const OtherIter &other) const { return base_ == other.base_; }
+        template<class OtherIter> bool operator!=(const OtherIter &other) const { return base_ != other.base_; }
+        /** @} */
+
+        /** Iterator comparison. */
+        bool operator<(const VertexBaseIterator &other) const { return base_ < other.base_; }
+    };
+
+public:
+    /** Bidirectional edge node iterator.
+     *
+     *  Iterates over edges, returning the @ref Edge when dereferenced.  Since the graph is immutable, all edge iterators are
+     *  const iterators. */
+    class ConstEdgeIterator: public EdgeBaseIterator<ConstEdgeIterator, const Edge> {
+        typedef                     EdgeBaseIterator<ConstEdgeIterator, const Edge> Super;
+    public:
+        typedef const Edge& Reference;
+        typedef const Edge* Pointer;
+        ConstEdgeIterator() {}
+        const Edge& operator*() const { return this->dereference(); }
+        const Edge* operator->() const { return &this->dereference(); }
+    private:
+        friend class CsrGraph;
+        ConstEdgeIterator(const Edge *edge, const Edge *end): Super(edge, end) {}
+        explicit ConstEdgeIterator(const Edge *const *slot): Super(slot) {}
+    };
+
+    /** Bidirectional edge value iterator.
+     *
+     *  Iterates over edges, returning the user-defined value when dereferenced. */
+    class ConstEdgeValueIterator: public EdgeBaseIterator<ConstEdgeValueIterator, const EdgeValue> {
+        typedef                          EdgeBaseIterator<ConstEdgeValueIterator, const EdgeValue> Super;
+    public:
+        typedef const EdgeValue& Reference;
+        typedef const EdgeValue* Pointer;
+        ConstEdgeValueIterator() {}
+        ConstEdgeValueIterator(const ConstEdgeIterator &other): Super(other) {}
+        const EdgeValue& operator*() const { return this->dereference().value(); }
+        const EdgeValue* operator->() const { return &this->dereference().value(); }
+    private:
+        friend class CsrGraph;
+        ConstEdgeValueIterator(const Edge *edge, const Edge *end): Super(edge, end) {}
+    };
+
+    /** Bidirectional vertex node iterator.
+     *
+     *  Iterates over vertices, returning the @ref Vertex when dereferenced.  Since the graph is immutable, all vertex iterators
+     *  are const iterators. */
+    class ConstVertexIterator: public VertexBaseIterator<ConstVertexIterator, const Vertex> {
+        typedef                       VertexBaseIterator<ConstVertexIterator, const Vertex> Super;
+    public:
+        typedef const Vertex& Reference;
+        typedef const Vertex* Pointer;
+        ConstVertexIterator() {}
+        const Vertex& operator*() const { return this->dereference(); }
+        const Vertex* operator->() const { return &this->dereference(); }
+    private:
+        friend class CsrGraph;
+        explicit ConstVertexIterator(const Vertex *base): Super(base) {}
+    };
+
+    /** Bidirectional vertex value iterator.
+     *
+     *  Iterates over vertices, returning the user-defined value when dereferenced. */
+    class ConstVertexValueIterator: public VertexBaseIterator<ConstVertexValueIterator, const VertexValue> {
+        typedef                            VertexBaseIterator<ConstVertexValueIterator, const VertexValue> Super;
+    public:
+        typedef const VertexValue& Reference;
+        typedef const VertexValue* Pointer;
+        ConstVertexValueIterator() {}
+        ConstVertexValueIterator(const ConstVertexIterator &other): Super(other) {}
+        const VertexValue& operator*() const { return this->dereference().value(); }
+        const VertexValue* operator->() const { return &this->dereference().value(); }
+    private:
+        friend class CsrGraph;
+        explicit ConstVertexValueIterator(const Vertex *base): Super(base) {}
+    };
+
+    // The snapshot is immutable, so the non-const names are aliases for the const iterators. This allows GraphTraits and the
+    // algorithms that use it to treat const and non-const snapshots alike.
+    typedef ConstEdgeIterator EdgeIterator;             /**< Same as @ref ConstEdgeIterator. */
+    typedef ConstEdgeValueIterator EdgeValueIterator;   /**< Same as @ref ConstEdgeValueIterator. */
+    typedef ConstVertexIterator VertexIterator;         /**< Same as @ref ConstVertexIterator. */
+    typedef ConstVertexValueIterator VertexValueIterator; /**< Same as @ref ConstVertexValueIterator. */
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Storage nodes
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Edge node.
+     *
+     *  These nodes contain all information about an edge and are the objects returned (by reference) when an edge iterator is
+     *  dereferenced. */
+    class Edge {
+        size_t id_;                                     // ID number, same as in the original graph
+        const Vertex *source_, *target_;                // endpoints
+        EdgeValue value_;                               // copy of user-defined data
+    private:
+        friend class CsrGraph;
+        Edge(size_t id, const Vertex *source, const Vertex *target, const EdgeValue &value)
+            : id_(id), source_(source), target_(target), value_(value) {}
+    public:
+        /** Unique edge ID number.
+         *
+         *  This is the ID number of the corresponding edge in the original graph.
+         *
+         *  Time complexity is constant. */
+        const size_t& id() const { return id_; }
+
+        /** Source vertex.
+         *
+         *  Time complexity is constant. */
+        ConstVertexIterator source() const { return ConstVertexIterator(source_); }
+
+        /** Target vertex.
+         *
+         *  Time complexity is constant. */
+        ConstVertexIterator target() const { return ConstVertexIterator(target_); }
+
+        /** User-defined value.
+         *
+         *  This is a copy of the value stored in the original graph when the snapshot was created.
+         *
+         *  Time complexity is constant. */
+        const EdgeValue& value() const { return value_; }
+
+        /** Determines if edge is a self-edge.
+         *
+         *  Returns true if this edge is a self edge.  A self edge is an edge whose source and target vertices are the same
+         *  vertex. */
+        bool isSelfEdge() const {
+            return source_ == target_;
+        }
+    };
+
+    /** Vertex node.
+     *
+     *  These nodes contain all information about a vertex and are the objects returned (by reference) when a vertex iterator
+     *  is dereferenced. */
+    class Vertex {
+        size_t id_;                                     // ID number, same as in the original graph
+        const Edge *outBegin_, *outEnd_;                // contiguous subrange of the edge array
+        const Edge *const *inBegin_;                    // null-terminated subrange of the in-edge array
+        size_t nInEdges_;
+        VertexValue value_;                             // copy of user-defined data
+    private:
+        friend class CsrGraph;
+        Vertex(size_t id, const VertexValue &value)
+            : id_(id), outBegin_(NULL), outEnd_(NULL), inBegin_(NULL), nInEdges_(0), value_(value) {}
+    public:
+        /** Unique vertex ID number.
+         *
+         *  This is the ID number of the corresponding vertex in the original graph.
+         *
+         *  Time complexity is constant. */
+        const size_t& id() const { return id_; }
+
+        /** List of incoming edges.
+         *
+         *  Returns a sublist of edges whose target vertex is this vertex, in the same order as the original graph.
+         *
+         *  Time complexity is constant. */
+        boost::iterator_range<ConstEdgeIterator> inEdges() const {
+            return boost::iterator_range<ConstEdgeIterator>(ConstEdgeIterator(inBegin_),
+                                                            ConstEdgeIterator(inBegin_ + nInEdges_));
+        }
+
+        /** List of outgoing edges.
+         *
+         *  Returns a sublist of edges whose source vertex is this vertex, in the same order as the original graph. The edges
+         *  are adjacent to each other in memory.
+         *
+         *  Time complexity is constant. */
+        boost::iterator_range<ConstEdgeIterator> outEdges() const {
+            return boost::iterator_range<ConstEdgeIterator>(ConstEdgeIterator(outBegin_, outEnd_),
+                                                            ConstEdgeIterator(outEnd_, outEnd_));
+        }
+
+        /** Number of incoming edges. */
+        size_t nInEdges() const {
+            return nInEdges_;
+        }
+
+        /** Number of outgoing edges. */
+        size_t nOutEdges() const {
+            return outEnd_ - outBegin_;
+        }
+
+        /** Number of incident edges.
+         *
+         *  Returns the total number of incident edges, the sum of @ref nInEdges and @ref nOutEdges.  Self-edges are counted
+         *  two times: once for the source end, and once for the target end. */
+        size_t degree() const {
+            return nInEdges() + nOutEdges();
+        }
+
+        /** User-defined value.
+         *
+         *  This is a copy of the value stored in the original graph when the snapshot was created.
+         *
+         *  Time complexity is constant. */
+        const VertexValue& value() const { return value_; }
+    };
+
+private:
+    std::vector<Vertex> vertices_;                      // indexed by vertex ID
+    std::vector<Edge> edges_;                           // grouped by source vertex
+    std::vector<const Edge*> inEdges_;                  // grouped by target vertex, each group followed by a null
+    std::vector<size_t> edgePositions_;                 // index into edges_ for each edge ID
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Initialization
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Default constructor.
+     *
+     *  Creates an empty snapshot. */
+    CsrGraph() {}
+
+    /** Create a snapshot of a graph.
+     *
+     *  Time complexity is linear in the number of vertices and edges. */
+    explicit CsrGraph(const OriginalGraph &graph) {
+        build(graph);
+    }
+
+    /** Copy constructor. */
+    CsrGraph(const CsrGraph &other) {
+        *this = other;
+    }
+
+    /** Assignment. */
+    CsrGraph& operator=(const CsrGraph &other) {
+        if (this != &other) {
+            vertices_ = other.vertices_;
+            edges_ = other.edges_;
+            inEdges_ = other.inEdges_;
+            edgePositions_ = other.edgePositions_;
+            relocate(other);
+        }
+        return *this;
+    }
+
+    /** Replace this snapshot with a snapshot of another graph.
+     *
+     *  Time complexity is linear in the number of vertices and edges. */
+    CsrGraph& operator=(const OriginalGraph &graph) {
+        build(graph);
+        return *this;
+    }
+
+    /** Remove all vertices and edges. */
+    void clear() {
+        vertices_.clear();
+        edges_.clear();
+        inEdges_.clear();
+        edgePositions_.clear();
+    }
+
+private:
+    void build(const OriginalGraph &graph) {
+        clear();
+
+        // Vertices are stored by ID. The vertex array is never resized after this, so pointers into it are stable.
+        vertices_.reserve(graph.nVertices());
+        for (size_t i=0; i<graph.nVertices(); ++i)
+            vertices_.push_back(Vertex(i, graph.findVertex(i)->value()));
+
+        // Edges grouped by source vertex.
+        edges_.reserve(graph.nEdges());
+        edgePositions_.resize(graph.nEdges());
+        for (size_t i=0; i<graph.nVertices(); ++i) {
+            BOOST_FOREACH (const typename OriginalGraph::Edge &edge, graph.findVertex(i)->outEdges()) {
+                edgePositions_[edge.id()] = edges_.size();
+                edges_.push_back(Edge(edge.id(), &vertices_[i], &vertices_[edge.target()->id()], edge.value()));
+            }
+        }
+
+        // Incoming edge pointers grouped by target vertex. The edge array is no longer resized, so pointers into it are stable.
+        inEdges_.reserve(graph.nEdges() + graph.nVertices());
+        std::vector<size_t> inOffsets(graph.nVertices());
+        size_t outOffset = 0;
+        for (size_t i=0; i<graph.nVertices(); ++i) {
+            typename OriginalGraph::ConstVertexIterator vertex = graph.findVertex(i);
+            inOffsets[i] = inEdges_.size();
+            BOOST_FOREACH (const typename OriginalGraph::Edge &edge, vertex->inEdges())
+                inEdges_.push_back(&edges_[edgePositions_[edge.id()]]);
+            inEdges_.push_back(NULL);
+            vertices_[i].nInEdges_ = vertex->nInEdges();
+            vertices_[i].outBegin_ = edges_.empty() ? NULL : &edges_[0] + outOffset;
+            outOffset += vertex->nOutEdges();
+            vertices_[i].outEnd_ = edges_.empty() ? NULL : &edges_[0] + outOffset;
+        }
+        for (size_t i=0; i<graph.nVertices(); ++i)
+            vertices_[i].inBegin_ = &inEdges_[inOffsets[i]];
+    }
+
+    // Adjust internal pointers after copying the arrays from another snapshot.
+    void relocate(const CsrGraph &other) {
+        for (size_t i=0; i<edges_.size(); ++i) {
+            edges_[i].source_ = &vertices_[other.edges_[i].source_ - &other.vertices_[0]];
+            edges_[i].target_ = &vertices_[other.edges_[i].target_ - &other.vertices_[0]];
+        }
+        for (size_t i=0; i<inEdges_.size(); ++i) {
+            if (inEdges_[i])
+                inEdges_[i] = &edges_[inEdges_[i] - &other.edges_[0]];
+        }
+        for (size_t i=0; i<vertices_.size(); ++i) {
+            const Vertex &src = other.vertices_[i];
+            Vertex &dst = vertices_[i];
+            if (!edges_.empty()) {
+                dst.outBegin_ = &edges_[0] + (src.outBegin_ - &other.edges_[0]);
+                dst.outEnd_ = &edges_[0] + (src.outEnd_ - &other.edges_[0]);
+            }
+            dst.inBegin_ = &inEdges_[0] + (src.inBegin_ - &other.inEdges_[0]);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Public methods
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Iterators for all vertices.
+     *
+     *  Returns a pair of vertex iterators that delineate the list of all vertices in ID order.
+     *
+     *  Time complexity is constant. */
+    boost::iterator_range<ConstVertexIterator> vertices() const {
+        const Vertex *base = vertices_.empty() ? NULL : &vertices_[0];
+        return boost::iterator_range<ConstVertexIterator>(ConstVertexIterator(base),
+                                                          ConstVertexIterator(base + vertices_.size()));
+    }
+
+    /** Iterators for all vertex values.
+     *
+     *  Time complexity is constant. */
+    boost::iterator_range<ConstVertexValueIterator> vertexValues() const {
+        const Vertex *base = vertices_.empty() ? NULL : &vertices_[0];
+        return boost::iterator_range<ConstVertexValueIterator>(ConstVertexValueIterator(base),
+                                                               ConstVertexValueIterator(base + vertices_.size()));
+    }
+
+    /** Iterators for all edges.
+     *
+     *  Returns a pair of edge iterators that delineate the list of all edges.  The edges are grouped by source vertex, which
+     *  is not necessarily the same order as in the original graph.
+     *
+     *  Time complexity is constant. */
+    boost::iterator_range<ConstEdgeIterator> edges() const {
+        const Edge *base = edges_.empty() ? NULL : &edges_[0];
+        const Edge *end = base + edges_.size();
+        return boost::iterator_range<ConstEdgeIterator>(ConstEdgeIterator(base, end), ConstEdgeIterator(end, end));
+    }
+
+    /** Iterators for all edge values.
+     *
+     *  Time complexity is constant. */
+    boost::iterator_range<ConstEdgeValueIterator> edgeValues() const {
+        const Edge *base = edges_.empty() ? NULL : &edges_[0];
+        const Edge *end = base + edges_.size();
+        return boost::iterator_range<ConstEdgeValueIterator>(ConstEdgeValueIterator(base, end),
+                                                             ConstEdgeValueIterator(end, end));
+    }
+
+    /** Finds the vertex with specified ID number.
+     *
+     *  Returns a vertex iterator for the vertex with the specified ID.  The ID must be valid.
+     *
+     *  Time complexity is constant. */
+    ConstVertexIterator findVertex(size_t id) const {
+        ASSERT_require(id < vertices_.size());
+        return ConstVertexIterator(&vertices_[id]);
+    }
+
+    /** Determines whether the vertex iterator is valid. */
+    bool isValidVertex(const ConstVertexIterator &vertex) const {
+        return vertex != vertices().end() && vertex->id() < nVertices() && vertex == findVertex(vertex->id());
+    }
+
+    /** Finds the edge with specified ID number.
+     *
+     *  Returns an edge iterator for the edge with the specified ID.  The ID must be valid.
+     *
+     *  Time complexity is constant. */
+    ConstEdgeIterator findEdge(size_t id) const {
+        ASSERT_require(id < edgePositions_.size());
+        const Edge *end = &edges_[0] + edges_.size();
+        return ConstEdgeIterator(&edges_[edgePositions_[id]], end);
+    }
+
+    /** Determines whether the edge iterator is valid. */
+    bool isValidEdge(const ConstEdgeIterator &edge) const {
+        return edge != edges().end() && edge->id() < nEdges() && edge == findEdge(edge->id());
+    }
+
+    /** Total number of vertices. */
+    size_t nVertices() const {
+        return vertices_.size();
+    }
+
+    /** Total number of edges. */
+    size_t nEdges() const {
+        return edges_.size();
+    }
+
+    /** True if graph is empty. */
+    bool isEmpty() const {
+        ASSERT_require(edges_.empty() || !vertices_.empty());
+        return vertices_.empty();
+    }
+};
+
+} // namespace
+} // namespace
+
+#endif
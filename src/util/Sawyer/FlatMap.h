@@ -0,0 +1,516 @@
+// WARNING: Changes to this file must be contributed back to Sawyer or else they will
+//          be clobbered by the next update from Sawyer.  The Sawyer repository is at
+//          https://github.com/matzke1/sawyer.
+
+
+
+
+#ifndef Sawyer_FlatMap_H
+#define Sawyer_FlatMap_H
+
+#include <Sawyer/Assert.h>
+#include <Sawyer/Optional.h>
+#include <Sawyer/Sawyer.h>
+#include <algorithm>
+#include <boost/range/iterator_range.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <vector>
+
+namespace Sawyer {
+namespace Container {
+
+/** %Container associating values with keys, stored in a sorted vector.
+ *
+ *  This container has the same interface as @ref Map for the operations that it supports, but rather than allocating one
+ *  red-black tree node per key it stores all key/value pairs contiguously in a single vector sorted by key.  Searching is a
+ *  binary search over contiguous memory, which is considerably faster than chasing tree pointers when the container is large,
+ *  and the container uses no per-node memory overhead.  The price is that inserting or erasing a node takes linear time
+ *  since subsequent nodes must be moved, except when inserting at the end of the container, which takes amortized constant
+ *  time.  Therefore this container is best suited for data that's built once (preferably in key order) and thereafter
+ *  mostly searched, such as a "frozen" copy of a map that's no longer being modified.
+ *
+ *  Unlike @ref Map, all iterators are invalidated by any operation that inserts or erases nodes. */
+template<class K,
+         class T,
+         class Cmp = std::less<K> >
+class FlatMap {
+public:
+    typedef K Key;                                      /**< Type for keys. */
+    typedef T Value;                                    /**< Type for values associated with each key. */
+    typedef Cmp Comparator;                             /**< Type of comparator, third template argument. */
+
+    /** Type for stored nodes.
+     *
+     *  A storage node contains the immutable key and its associated value. */
+    class Node {
+        Key key_;
+        Value value_;
+    public:
+        Node(const Key &key, const Value &value): key_(key), value_(value) {}
+
+        /** Key part of key/value node.
+         *
+         *  Returns the key part of a key/value node. Keys are not mutable when they are part of a map. */
+        const Key& key() const { return key_; }
+
+        /** Value part of key/value node.
+         *
+         *  Returns a reference to the value part of a key/value node.
+         *
+         * @{ */
+        Value& value() { return value_; }
+        const Value& value() const { return value_; }
+        /** @} */
+    };
+
+private:
+    typedef std::vector<Node> Nodes;
+
+    // Compares nodes with keys so that the standard binary searches can operate directly on the node vector.
+    class NodeKeyCompare {
+        Comparator cmp_;
+    public:
+        explicit NodeKeyCompare(const Comparator &cmp): cmp_(cmp) {}
+        bool operator()(const Node &node, const Key &key) const { return cmp_(node.key(), key); }
+        bool operator()(const Key &key, const Node &node) const { return cmp_(key, node.key()); }
+    };
+
+    Nodes nodes_;
+    Comparator comparator_;
+
+private:
+    friend class boost::serialization::access;
+
+    template<class S>
+    void save(S &s, const unsigned /*version*/) const {
+        size_t n = nodes_.size();
+        s <<BOOST_SERIALIZATION_NVP(n);
+        for (typename Nodes::const_iterator iter=nodes_.begin(); iter!=nodes_.end(); ++iter) {
+            s <<boost::serialization::make_nvp("key", iter->key());
+            s <<boost::serialization::make_nvp("value", iter->value());
+        }
+    }
+
+    template<class S>
+    void load(S &s, const unsigned /*version*/) {
+        clear();
+        size_t n = 0;
+        s >>BOOST_SERIALIZATION_NVP(n);
+        nodes_.reserve(n);
+        for (size_t i=0; i<n; ++i) {
+            Key key;
+            Value value;
+            s >>BOOST_SERIALIZATION_NVP(key);
+            s >>BOOST_SERIALIZATION_NVP(value);
+            nodes_.push_back(Node(key, value));         // saved in sorted order
+        }
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Iterators
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+private:
+    template<class Derived, class Value, class BaseIterator>
+    class BidirectionalIterator: public std::iterator<std::bidirectional_iterator_tag, Value> {
+    protected:
+        BaseIterator base_;
+        BidirectionalIterator() {}
+        BidirectionalIterator(const BaseIterator &base): base_(base) {}
+    public:
+        Derived& operator=(const Derived &other) { base_ = other.base_; return *derived(); }
+        Derived& operator++() { ++base_; return *derived(); }
+        Derived operator++(int) { Derived old=*derived(); ++*this; return old; }
+        Derived& operator--() { --base_; return *derived(); }
+        Derived operator--(int) { Derived old=*derived(); --*this; return old; }
+        template<class OtherIter> bool operator==(const OtherIter &other) const { return base_ == other.base(); }
+        template<class OtherIter> bool operator!=(const OtherIter &other) const { return base_ != other.base(); }
+        const BaseIterator& base() const { return base_; }
+    protected:
+        Derived* derived() { return static_cast<Derived*>(this); }
+        const Derived* derived() const { return static_cast<const Derived*>(this); }
+    };
+
+public:
+    /** Bidirectional iterator over key/value nodes.
+     *
+     *  Dereferencing this iterator will return a Node from which both the key and the value can be obtained. Node iterators
+     *  are implicitly convertible to both key and value iterators. */
+    class NodeIterator: public BidirectionalIterator<NodeIterator, Node, typename Nodes::iterator> {
+        typedef                BidirectionalIterator<NodeIterator, Node, typename Nodes::iterator> Super;
+    public:
+        NodeIterator() {}
+        NodeIterator(const NodeIterator &other): Super(other) {}
+        Node& operator*() const { return *this->base_; }
+        Node* operator->() const { return &*this->base_; }
+    private:
+        friend class FlatMap;
+        NodeIterator(const typename Nodes::iterator &base): Super(base) {}
+    };
+
+    /** Bidirectional iterator over key/value nodes.
+     *
+     *  Dereferencing this iterator will return a Node from which both the key and the value can be obtained. Node iterators
+     *  are implicitly convertible to both key and value iterators. */
+    class ConstNodeIterator: public BidirectionalIterator<ConstNodeIterator, const Node, typename Nodes::const_iterator> {
+        typedef                     BidirectionalIterator<ConstNodeIterator, const Node, typename Nodes::const_iterator> Super;
+    public:
+        ConstNodeIterator() {}
+        ConstNodeIterator(const ConstNodeIterator &other): Super(other) {}
+        ConstNodeIterator(const NodeIterator &other): Super(typename Nodes::const_iterator(other.base())) {}
+        const Node& operator*() const { return *this->base_; }
+        const Node* operator->() const { return &*this->base_; }
+    private:
+        friend class FlatMap;
+        ConstNodeIterator(const typename Nodes::const_iterator &base): Super(base) {}
+    };
+
+    /** Bidirectional iterator over keys.
+     *
+     *  Dereferencing this iterator will return a reference to a const key.  Keys cannot be altered while they are a member of
+     *  this container. */
+    class ConstKeyIterator: public BidirectionalIterator<ConstKeyIterator, const Key, typename Nodes::const_iterator> {
+        typedef                    BidirectionalIterator<ConstKeyIterator, const Key, typename Nodes::const_iterator> Super;
+    public:
+        ConstKeyIterator() {}
+        ConstKeyIterator(const ConstKeyIterator &other): Super(other) {}
+        ConstKeyIterator(const NodeIterator &other): Super(typename Nodes::const_iterator(other.base())) {}
+        ConstKeyIterator(const ConstNodeIterator &other): Super(other.base()) {}
+        const Key& operator*() const { return this->base()->key(); }
+        const Key* operator->() const { return &this->base()->key(); }
+    };
+
+    /** Bidirectional iterator over values.
+     *
+     *  Dereferencing this iterator will return a reference to the user-defined value of the node.  Values may be altered
+     *  in-place while they are members of a container. */
+    class ValueIterator: public BidirectionalIterator<ValueIterator, Value, typename Nodes::iterator> {
+        typedef                 BidirectionalIterator<ValueIterator, Value, typename Nodes::iterator> Super;
+    public:
+        ValueIterator() {}
+        ValueIterator(const ValueIterator &other): Super(other) {}
+        ValueIterator(const NodeIterator &other): Super(other.base()) {}
+        Value& operator*() const { return this->base()->value(); }
+        Value* operator->() const { return &this->base()->value(); }
+    };
+
+    /** Bidirectional iterator over values.
+     *
+     *  Dereferencing this iterator will return a reference to the user-defined value of the node.  Values may be altered
+     *  in-place while they are members of a container. */
+    class ConstValueIterator: public BidirectionalIterator<ConstValueIterator, const Value, typename Nodes::const_iterator> {
+        typedef BidirectionalIterator<ConstValueIterator, const Value, typename Nodes::const_iterator> Super;
+    public:
+        ConstValueIterator() {}
+        ConstValueIterator(const ConstValueIterator &other): Super(other) {}
+        ConstValueIterator(const ValueIterator &other): Super(typename Nodes::const_iterator(other.base())) {}
+        ConstValueIterator(const ConstNodeIterator &other): Super(other.base()) {}
+        ConstValueIterator(const NodeIterator &other): Super(typename Nodes::const_iterator(other.base())) {}
+        const Value& operator*() const { return this->base()->value(); }
+        const Value* operator->() const { return &this->base()->value(); }
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Default constructor.
+     *
+     *  Creates an empty map. */
+    FlatMap() {}
+
+    /** Constructs an empty map.
+     *
+     *  This is like the default constructor, but a comparer can be specified. */
+    explicit FlatMap(const Comparator &comparator)
+        : comparator_(comparator) {}
+
+    /** Copy constructor.
+     *
+     *  Initializes the new map with copies of the nodes of the @p other map, which can be any container having the @ref Map
+     *  interface.  The keys and values must be convertible from the other map to this map. When the other map is sorted the
+     *  same way as this map, this constructor executes in linear time. */
+    template<class OtherMap>
+    explicit FlatMap(const OtherMap &other) {
+        nodes_.reserve(other.size());
+        insertMultiple(other.nodes());
+    }
+
+    /** Make this map be a copy of another map.
+     *
+     *  The keys and values of the @p other map must be convertible to the types used for this map. */
+    template<class OtherMap>
+    FlatMap& operator=(const OtherMap &other) {
+        clear();
+        nodes_.reserve(other.size());
+        insertMultiple(other.nodes());
+        return *this;
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Iteration
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Iterators for container nodes.
+     *
+     *  This returns a range of node-iterators that will traverse all nodes (key/value pairs) of this container.
+     *
+     * @{ */
+    boost::iterator_range<NodeIterator> nodes() {
+        return boost::iterator_range<NodeIterator>(NodeIterator(nodes_.begin()), NodeIterator(nodes_.end()));
+    }
+    boost::iterator_range<ConstNodeIterator> nodes() const {
+        return boost::iterator_range<ConstNodeIterator>(ConstNodeIterator(nodes_.begin()), ConstNodeIterator(nodes_.end()));
+    }
+    /** @} */
+
+    /** Iterators for container keys.
+     *
+     *  Returns a range of key-iterators that will traverse the keys of this container.
+     *
+     * @{ */
+    boost::iterator_range<ConstKeyIterator> keys() {
+        return boost::iterator_range<ConstKeyIterator>(NodeIterator(nodes_.begin()), NodeIterator(nodes_.end()));
+    }
+    boost::iterator_range<ConstKeyIterator> keys() const {
+        return boost::iterator_range<ConstKeyIterator>(ConstNodeIterator(nodes_.begin()), ConstNodeIterator(nodes_.end()));
+    }
+    /** @} */
+
+    /** Iterators for container values.
+     *
+     *  Returns a range of iterators that will traverse the user-defined values of this container.  The values are iterated in
+     *  key order, although the keys are not directly available via these iterators.
+     *
+     * @{ */
+    boost::iterator_range<ValueIterator> values() {
+        return boost::iterator_range<ValueIterator>(NodeIterator(nodes_.begin()), NodeIterator(nodes_.end()));
+    }
+    boost::iterator_range<ConstValueIterator> values() const {
+        return boost::iterator_range<ConstValueIterator>(ConstNodeIterator(nodes_.begin()), ConstNodeIterator(nodes_.end()));
+    }
+    /** @} */
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Size and capacity
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Determines whether this container is empty.
+     *
+     *  Returns true if the container is empty, and false if it has at least one node. This method executes in constant time. */
+    bool isEmpty() const {
+        return nodes_.empty();
+    }
+
+    /** Number of nodes, keys, or values in this container.
+     *
+     *  Returns the number of nodes currently in this container. This method executes in constant time. */
+    size_t size() const {
+        return nodes_.size();
+    }
+
+    /** Reserve space for nodes.
+     *
+     *  Preallocates space for at least @p n nodes so that inserting up to that many nodes doesn't reallocate storage. */
+    void reserve(size_t n) {
+        nodes_.reserve(n);
+    }
+
+    /** Release unused space.
+     *
+     *  Reduces the storage used by this container to what's needed for its current nodes. This is typically called after a
+     *  container has been fully populated. */
+    void shrink() {
+        Nodes(nodes_).swap(nodes_);
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Searching
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Find a node by key.
+     *
+     *  Looks for a node whose key is equal to the specified @p key and returns an iterator to that node, or the end iterator
+     *  if no such node exists.  Two keys are considered equal if this container's @ref Comparator object returns false
+     *  reflexively. The method executes in logorithmic time based on the number of nodes in the container.
+     *
+     * @{ */
+    NodeIterator find(const Key &key) {
+        typename Nodes::iterator lb = std::lower_bound(nodes_.begin(), nodes_.end(), key, NodeKeyCompare(comparator_));
+        return lb==nodes_.end() || comparator_(key, lb->key()) ? NodeIterator(nodes_.end()) : NodeIterator(lb);
+    }
+    ConstNodeIterator find(const Key &key) const {
+        typename Nodes::const_iterator lb = std::lower_bound(nodes_.begin(), nodes_.end(), key, NodeKeyCompare(comparator_));
+        return lb==nodes_.end() || comparator_(key, lb->key()) ? ConstNodeIterator(nodes_.end()) : ConstNodeIterator(lb);
+    }
+    /** @} */
+
+    /** Determine if a key exists.
+     *
+     *  Looks for a node whose key is equal to the specified @p key and returns true if found, or false if no such node
+     *  exists. */
+    bool exists(const Key &key) const {
+        return find(key) != nodes().end();
+    }
+
+    /** Find a node close to a key.
+     *
+     *  Finds the first node whose key is not less than (i.e., greater than or equal to) the specified @p key. Returns the end
+     *  iterator if no such node exists.  This method executes in logarithmic time.
+     *
+     * @{ */
+    NodeIterator lowerBound(const Key &key) {
+        return NodeIterator(std::lower_bound(nodes_.begin(), nodes_.end(), key, NodeKeyCompare(comparator_)));
+    }
+    ConstNodeIterator lowerBound(const Key &key) const {
+        return ConstNodeIterator(std::lower_bound(nodes_.begin(), nodes_.end(), key, NodeKeyCompare(comparator_)));
+    }
+    /** @} */
+
+    /** Find a node close to a key.
+     *
+     *  Finds the first node whose key is greater than the specified @p key.  Returns the end iterator if no such node exists.
+     *  This method executes in logarithmic time.
+     *
+     * @{ */
+    NodeIterator upperBound(const Key &key) {
+        return NodeIterator(std::upper_bound(nodes_.begin(), nodes_.end(), key, NodeKeyCompare(comparator_)));
+    }
+    ConstNodeIterator upperBound(const Key &key) const {
+        return ConstNodeIterator(std::upper_bound(nodes_.begin(), nodes_.end(), key, NodeKeyCompare(comparator_)));
+    }
+    /** @} */
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Accessors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Lookup and return an existing value.
+     *
+     *  Returns a reference to the value associated with the specified @p key, or throws an <code>std::domain_error</code> if
+     *  the key does not exist.
+     *
+     * @{ */
+    Value& get(const Key &key) {
+        NodeIterator found = find(key);
+        if (found == nodes().end())
+            throw std::domain_error("key lookup failure; key is not in map domain");
+        return found->value();
+    }
+    const Value& get(const Key &key) const {
+        ConstNodeIterator found = find(key);
+        if (found == nodes().end())
+            throw std::domain_error("key lookup failure; key is not in map domain");
+        return found->value();
+    }
+    /** @} */
+
+    /** Lookup and return a value or nothing.
+     *
+     *  Looks up the node with the specified key and returns either a copy of its value, or nothing. */
+    Optional<Value> getOptional(const Key &key) const {
+        ConstNodeIterator found = find(key);
+        return found == nodes().end() ? Optional<Value>() : Optional<Value>(found->value());
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Mutators
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Insert or update a key/value pair.
+     *
+     *  Inserts the key/value pair into the container. If a previous node already had the same key then its value is replaced
+     *  by the new value.  Inserting a key that's greater than all existing keys takes amortized constant time; other inserts
+     *  take linear time. */
+    FlatMap& insert(const Key &key, const Value &value) {
+        if (nodes_.empty() || comparator_(nodes_.back().key(), key)) {
+            nodes_.push_back(Node(key, value));
+        } else {
+            typename Nodes::iterator lb = std::lower_bound(nodes_.begin(), nodes_.end(), key, NodeKeyCompare(comparator_));
+            if (lb!=nodes_.end() && !comparator_(key, lb->key())) {
+                lb->value() = value;
+            } else {
+                nodes_.insert(lb, Node(key, value));
+            }
+        }
+        return *this;
+    }
+
+    /** Insert multiple values.
+     *
+     *  Inserts copies of the nodes in the specified node iterator range. The iterators must iterate over objects that have
+     *  <code>key</code> and <code>value</code> methods that return keys and values that are convertible to the types used by
+     *  this container.  Inserting nodes in key order is most efficient.
+     *
+     * @{ */
+    template<class OtherNodeIterator>
+    FlatMap& insertMultiple(const OtherNodeIterator &begin, const OtherNodeIterator &end) {
+        for (OtherNodeIterator otherIter=begin; otherIter!=end; ++otherIter)
+            insert(Key(otherIter->key()), Value(otherIter->value()));
+        return *this;
+    }
+    template<class OtherNodeIterator>
+    FlatMap& insertMultiple(const boost::iterator_range<OtherNodeIterator> &range) {
+        return insertMultiple(range.begin(), range.end());
+    }
+    /** @} */
+
+    /** Remove all nodes.
+     *
+     *  All nodes are removed from this container. */
+    FlatMap& clear() {
+        nodes_.clear();
+        return *this;
+    }
+
+    /** Remove a node with specified key.
+     *
+     *  Removes the node whose key is equal to the specified key, or does nothing if no such node exists. */
+    FlatMap& erase(const Key &key) {
+        NodeIterator found = find(key);
+        if (found != nodes().end())
+            nodes_.erase(found.base());
+        return *this;
+    }
+
+    /** Remove a node by iterator.
+     *
+     *  Removes the node referenced by @p iter. The iterator must reference a valid node in this container. */
+    FlatMap& eraseAt(const NodeIterator &iter) {
+        nodes_.erase(iter.base());
+        return *this;
+    }
+
+    /** Remove multiple nodes by iterator range.
+     *
+     *  The iterator range must contain iterators that point into this container.
+     *
+     * @{ */
+    FlatMap& eraseAtMultiple(const NodeIterator &begin, const NodeIterator &end) {
+        nodes_.erase(begin.base(), end.base());
+        return *this;
+    }
+    FlatMap& eraseAtMultiple(const boost::iterator_range<NodeIterator> &range) {
+        return eraseAtMultiple(range.begin(), range.end());
+    }
+    /** @} */
+};
+
+} // namespace
+} // namespace
+
+#endif
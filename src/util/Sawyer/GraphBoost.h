@@ -16,6 +16,7 @@
 #ifndef Sawyer_GraphBoost_H
 #define Sawyer_GraphBoost_H
 
+#include <Sawyer/CsrGraph.h>
 #include <Sawyer/Graph.h>
 #include <Sawyer/Sawyer.h>
 #include <boost/foreach.hpp>
@@ -41,6 +42,10 @@ namespace Sawyer {
  *  
  *  Const graphs implement the same concepts except MutablePropertyGraph and MutableGraph.
  *
+ *  Sawyer::Container::CsrGraph snapshots implement the same concepts as const graphs regardless of whether the snapshot itself
+ *  is const, and additionally map the BGL @c vertex_name property to the user-defined vertex value so that they can be used
+ *  with code written for BGL control flow graphs whose @c vertex_name property is the basic block.
+ *
  *  Vertex and edge iterators in the BGL domain map to VertexOuterIterator and EdgeOuterIterator types, which are defined in
  *  this namespace and have implicit conversions from Sawyer::Container::Graph::VertexIterator and
  *  Sawyer::Container::Graph::EdgeIterator. There are also const versions.  These outer iterators produce BGL
@@ -189,6 +194,24 @@ public:
     // size_t* operator->() const; //no methods defined on size_t, so not needed
 };
 
+// BGL vertex and edge iterators for Sawyer::Container::CsrGraph. Snapshots are immutable, so there is only one flavor which
+// wraps either a vertex iterator or an edge iterator.
+template<class BaseIter>
+class CsrOuterIterator: public std::iterator<std::bidirectional_iterator_tag, const size_t> {
+private:
+    BaseIter base_;
+public:
+    CsrOuterIterator() {}
+    explicit CsrOuterIterator(const BaseIter &base): base_(base) {}
+    CsrOuterIterator& operator++() { ++base_; return *this; }
+    CsrOuterIterator& operator--() { --base_; return *this; }
+    CsrOuterIterator operator++(int) { CsrOuterIterator old = *this; ++base_; return old; }
+    CsrOuterIterator operator--(int) { CsrOuterIterator old = *this; --base_; return old; }
+    bool operator==(const CsrOuterIterator &other) const { return base_ == other.base_; }
+    bool operator!=(const CsrOuterIterator &other) const { return base_ != other.base_; }
+    const size_t& operator*() const { return base_->id(); }
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Internal properties
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -897,5 +920,155 @@ add_vertex(const typename graph_traits<Sawyer::Container::Graph<V, E, VKey, EKey
     return graph.insertVertex(pval)->id();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      CsrGraph snapshots
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Snapshots are immutable, so the const and non-const graph traits are the same and all functions operate on const snapshots.
+template<class G>
+struct graph_traits<Sawyer::Container::CsrGraph<G> > {
+    typedef bidirectional_graph_tag traversal_category;
+
+    // Graph concepts
+    typedef size_t vertex_descriptor;
+    typedef size_t edge_descriptor;
+    typedef directed_tag directed_category;
+    typedef allow_parallel_edge_tag edge_parallel_category;
+    static size_t null_vertex() { return (size_t)(-1); }
+
+    // VertexListGraph concepts
+    typedef Sawyer::Boost::CsrOuterIterator<typename Sawyer::Container::CsrGraph<G>::ConstVertexIterator> vertex_iterator;
+    typedef size_t vertices_size_type;
+
+    // EdgeListGraph concepts
+    typedef Sawyer::Boost::CsrOuterIterator<typename Sawyer::Container::CsrGraph<G>::ConstEdgeIterator> edge_iterator;
+    typedef size_t edges_size_type;
+
+    // IncidenceGraph concepts
+    typedef edge_iterator out_edge_iterator;
+    typedef size_t degree_size_type;
+
+    // BidirectionalGraph concepts
+    typedef edge_iterator in_edge_iterator;
+};
+
+template<class G>
+struct graph_traits<const Sawyer::Container::CsrGraph<G> >: graph_traits<Sawyer::Container::CsrGraph<G> > {};
+
+template<class G>
+std::pair<typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_iterator,
+          typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_iterator>
+vertices(const Sawyer::Container::CsrGraph<G> &graph) {
+    typedef typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_iterator Iter;
+    return std::make_pair(Iter(graph.vertices().begin()), Iter(graph.vertices().end()));
+}
+
+template<class G>
+typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertices_size_type
+num_vertices(const Sawyer::Container::CsrGraph<G> &graph) {
+    return graph.nVertices();
+}
+
+template<class G>
+std::pair<typename graph_traits<Sawyer::Container::CsrGraph<G> >::edge_iterator,
+          typename graph_traits<Sawyer::Container::CsrGraph<G> >::edge_iterator>
+edges(const Sawyer::Container::CsrGraph<G> &graph) {
+    typedef typename graph_traits<Sawyer::Container::CsrGraph<G> >::edge_iterator Iter;
+    return std::make_pair(Iter(graph.edges().begin()), Iter(graph.edges().end()));
+}
+
+template<class G>
+typename graph_traits<Sawyer::Container::CsrGraph<G> >::edges_size_type
+num_edges(const Sawyer::Container::CsrGraph<G> &graph) {
+    return graph.nEdges();
+}
+
+template<class G>
+typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor
+source(typename graph_traits<Sawyer::Container::CsrGraph<G> >::edge_descriptor edge,
+       const Sawyer::Container::CsrGraph<G> &graph) {
+    return graph.findEdge(edge)->source()->id();
+}
+
+template<class G>
+typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor
+target(typename graph_traits<Sawyer::Container::CsrGraph<G> >::edge_descriptor edge,
+       const Sawyer::Container::CsrGraph<G> &graph) {
+    return graph.findEdge(edge)->target()->id();
+}
+
+template<class G>
+std::pair<typename graph_traits<Sawyer::Container::CsrGraph<G> >::out_edge_iterator,
+          typename graph_traits<Sawyer::Container::CsrGraph<G> >::out_edge_iterator>
+out_edges(typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor vertex,
+          const Sawyer::Container::CsrGraph<G> &graph) {
+    typedef typename graph_traits<Sawyer::Container::CsrGraph<G> >::out_edge_iterator Iter;
+    typename Sawyer::Container::CsrGraph<G>::ConstVertexIterator v = graph.findVertex(vertex);
+    return std::make_pair(Iter(v->outEdges().begin()), Iter(v->outEdges().end()));
+}
+
+template<class G>
+typename graph_traits<Sawyer::Container::CsrGraph<G> >::degree_size_type
+out_degree(typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor vertex,
+           const Sawyer::Container::CsrGraph<G> &graph) {
+    return graph.findVertex(vertex)->nOutEdges();
+}
+
+template<class G>
+std::pair<typename graph_traits<Sawyer::Container::CsrGraph<G> >::in_edge_iterator,
+          typename graph_traits<Sawyer::Container::CsrGraph<G> >::in_edge_iterator>
+in_edges(typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor vertex,
+         const Sawyer::Container::CsrGraph<G> &graph) {
+    typedef typename graph_traits<Sawyer::Container::CsrGraph<G> >::in_edge_iterator Iter;
+    typename Sawyer::Container::CsrGraph<G>::ConstVertexIterator v = graph.findVertex(vertex);
+    return std::make_pair(Iter(v->inEdges().begin()), Iter(v->inEdges().end()));
+}
+
+template<class G>
+typename graph_traits<Sawyer::Container::CsrGraph<G> >::degree_size_type
+in_degree(typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor vertex,
+          const Sawyer::Container::CsrGraph<G> &graph) {
+    return graph.findVertex(vertex)->nInEdges();
+}
+
+template<class G>
+typename graph_traits<Sawyer::Container::CsrGraph<G> >::degree_size_type
+degree(typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor vertex,
+       const Sawyer::Container::CsrGraph<G> &graph) {
+    return graph.findVertex(vertex)->degree();
+}
+
+template<class G>
+typename property_map<Sawyer::Container::CsrGraph<G>, Sawyer::Boost::vertex_value_t>::const_type
+get(Sawyer::Boost::vertex_value_t, const Sawyer::Container::CsrGraph<G> &graph) {
+    return Sawyer::Boost::ConstVertexPropertyMap<const Sawyer::Container::CsrGraph<G> >(graph);
+}
+
+template<class G>
+typename property_map<Sawyer::Container::CsrGraph<G>, Sawyer::Boost::edge_value_t>::const_type
+get(Sawyer::Boost::edge_value_t, const Sawyer::Container::CsrGraph<G> &graph) {
+    return Sawyer::Boost::ConstEdgePropertyMap<const Sawyer::Container::CsrGraph<G> >(graph);
+}
+
+template<class G>
+typename property_map<Sawyer::Container::CsrGraph<G>, Sawyer::Boost::vertex_id_t>::const_type
+get(Sawyer::Boost::vertex_id_t, const Sawyer::Container::CsrGraph<G> &graph) {
+    return Sawyer::Boost::ConstVertexIdPropertyMap<const Sawyer::Container::CsrGraph<G> >(graph);
+}
+
+template<class G>
+typename property_map<Sawyer::Container::CsrGraph<G>, Sawyer::Boost::edge_id_t>::const_type
+get(Sawyer::Boost::edge_id_t, const Sawyer::Container::CsrGraph<G> &graph) {
+    return Sawyer::Boost::ConstEdgeIdPropertyMap<const Sawyer::Container::CsrGraph<G> >(graph);
+}
+
+// The BGL vertex_name property is the user-defined vertex value.
+template<class G>
+const typename Sawyer::Container::CsrGraph<G>::VertexValue&
+get(vertex_name_t, const Sawyer::Container::CsrGraph<G> &graph,
+    typename graph_traits<Sawyer::Container::CsrGraph<G> >::vertex_descriptor vertex) {
+    return graph.findVertex(vertex)->value();
+}
+
 } // namespace
 #endif
@@ -10,6 +10,8 @@
 
 #include <boost/cstdint.hpp>
 #include <Sawyer/Assert.h>
+#include <Sawyer/BTreeMap.h>
+#include <Sawyer/FlatMap.h>
 #include <Sawyer/Map.h>
 #include <Sawyer/Optional.h>
 #include <Sawyer/Sawyer.h>
@@ -87,6 +89,40 @@ public:
     }
 };
 
+/** Storage policy that keeps IntervalMap nodes in a red-black tree.
+ *
+ *  This is the default storage for @ref IntervalMap. Each interval/value node is allocated separately, iterators remain valid
+ *  until the node they point to is erased, and all operations are logarithmic in the number of nodes.  See @ref Map. */
+struct MapStorage {
+    template<class K, class V, class Cmp>
+    struct Storage {
+        typedef Map<K, V, Cmp> Type;
+    };
+};
+
+/** Storage policy that keeps IntervalMap nodes in a B+-tree with contiguous leaves.
+ *
+ *  Searching and iterating are faster than @ref MapStorage for large containers and far fewer allocations are made, but any
+ *  insertion or erasure invalidates all iterators. See @ref BTreeMap. */
+struct BTreeStorage {
+    template<class K, class V, class Cmp>
+    struct Storage {
+        typedef BTreeMap<K, V, Cmp> Type;
+    };
+};
+
+/** Storage policy that keeps IntervalMap nodes in a sorted vector.
+ *
+ *  This is the most compact and fastest storage for searching and iterating, but inserting or erasing anywhere other than the
+ *  end of the container takes linear time and invalidates all iterators. It's intended for maps that are built once and
+ *  thereafter only queried, such as a "frozen" copy made with the converting constructor. See @ref FlatMap. */
+struct FlatStorage {
+    template<class K, class V, class Cmp>
+    struct Storage {
+        typedef FlatMap<K, V, Cmp> Type;
+    };
+};
+
 /** An associative container whose keys are non-overlapping intervals.
  *
  *  This container is somewhat like an STL <code>std::map</code> in that it stores key/value pairs.  However, it is optimized
@@ -158,6 +194,17 @@ public:
  *  }
  * @endcode
  *
+ *  The optional fourth template argument chooses how the nodes are stored. The default, @ref MapStorage, uses a red-black
+ *  tree. @ref BTreeStorage uses a B+-tree with contiguous leaves, which is faster and smaller for containers with very many
+ *  nodes, and @ref FlatStorage uses a sorted vector which is fastest to search but slow to modify.  All storage policies
+ *  provide the same container API, but with the latter two any insertion or erasure invalidates all iterators.  A map can be
+ *  converted to different storage with the converting constructor, such as freezing a map once it's fully built:
+ *
+ * @code
+ *  IntervalMap<AddressInterval, Stats> map = ...;
+ *  IntervalMap<AddressInterval, Stats, MergePolicy<AddressInterval, Stats>, FlatStorage> frozen(map);
+ * @endcode
+ *
  *  Besides <code>nodes()</code>, there's also <code>values()</code> and <code>intervals()</code> that return bidirectional
  *  iterators over the user-defined values or the intervals when dereferenced.
  *
@@ -167,11 +214,12 @@ public:
  * @sa
  *
  *  See @ref IntervalSetMap for a similar container that stores sets of values per interval. */
-template<typename I, typename T, class Policy = MergePolicy<I, T> >
+template<typename I, typename T, class Policy = MergePolicy<I, T>, class Storage = MapStorage>
 class IntervalMap {
 public:
     typedef I Interval;                                 /**< Interval type. */
     typedef T Value;                                    /**< Value type. */
+    typedef Storage StoragePolicy;                      /**< Storage policy, fourth template argument. */
 
 private:
     // Nodes of the underlying map are sorted by their last value so that we can use that map's lowerBound method to find the
@@ -187,7 +235,7 @@ private:
 
 public:
     /** Type of the underlying map. */
-    typedef Container::Map<Interval, Value, IntervalCompare> Map;
+    typedef typename Storage::template Storage<Interval, Value, IntervalCompare>::Type Map;
 
     /** Storage node.
      *
@@ -249,10 +297,10 @@ public:
      *
      *  Initialize this container by copying all nodes from the @p other container.  This constructor has <em>O(n)</em>
      *  complexity, where <em>n</em> is the number of nodes in the container. */
-    template<class Interval2, class T2, class Policy2>
-    IntervalMap(const IntervalMap<Interval2, T2, Policy2> &other) {
-        typedef typename IntervalMap<Interval2, T2, Policy2>::ConstNodeIterator OtherIterator;
-        for (OtherIterator otherIter=other.nodes().begin(); other!=other.nodes().end(); ++other)
+    template<class Interval2, class T2, class Policy2, class Storage2>
+    IntervalMap(const IntervalMap<Interval2, T2, Policy2, Storage2> &other): size_(0) {
+        typedef typename IntervalMap<Interval2, T2, Policy2, Storage2>::ConstNodeIterator OtherIterator;
+        for (OtherIterator otherIter=other.nodes().begin(); otherIter!=other.nodes().end(); ++otherIter)
             insert(Interval(otherIter->key()), Value(otherIter->value()));
     }
 
@@ -260,11 +308,11 @@ public:
      *
      *  Makes this container look like the @p other container by clearing this container and then copying all nodes from the
      *  other container. */
-    template<class Interval2, class T2, class Policy2>
-    IntervalMap& operator=(const IntervalMap<Interval2, T2, Policy2> &other) {
+    template<class Interval2, class T2, class Policy2, class Storage2>
+    IntervalMap& operator=(const IntervalMap<Interval2, T2, Policy2, Storage2> &other) {
         clear();
-        typedef typename IntervalMap<Interval2, T2, Policy2>::ConstNodeIterator OtherIterator;
-        for (OtherIterator otherIter=other.nodes().begin(); other!=other.nodes().end(); ++other)
+        typedef typename IntervalMap<Interval2, T2, Policy2, Storage2>::ConstNodeIterator OtherIterator;
+        for (OtherIterator otherIter=other.nodes().begin(); otherIter!=other.nodes().end(); ++otherIter)
             insert(Interval(otherIter->key()), Value(otherIter->value()));
         return *this;
     }
@@ -439,26 +487,26 @@ public:
      *  their respective containers.
      *
      * @{ */
-    template<typename T2, class Policy2>
-    std::pair<NodeIterator, typename IntervalMap<Interval, T2, Policy2>::ConstNodeIterator>
-    findFirstOverlap(typename IntervalMap::NodeIterator thisIter, const IntervalMap<Interval, T2, Policy2> &other,
-                     typename IntervalMap<Interval, T2, Policy2>::ConstNodeIterator otherIter) {
+    template<typename T2, class Policy2, class Storage2>
+    std::pair<NodeIterator, typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator>
+    findFirstOverlap(typename IntervalMap::NodeIterator thisIter, const IntervalMap<Interval, T2, Policy2, Storage2> &other,
+                     typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator otherIter) {
         return findFirstOverlapImpl(*this, thisIter, other, otherIter);
     }
-    template<typename T2, class Policy2>
-    std::pair<ConstNodeIterator, typename IntervalMap<Interval, T2, Policy2>::ConstNodeIterator>
-    findFirstOverlap(typename IntervalMap::ConstNodeIterator thisIter, const IntervalMap<Interval, T2, Policy2> &other,
-                     typename IntervalMap<Interval, T2, Policy2>::ConstNodeIterator otherIter) const {
+    template<typename T2, class Policy2, class Storage2>
+    std::pair<ConstNodeIterator, typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator>
+    findFirstOverlap(typename IntervalMap::ConstNodeIterator thisIter, const IntervalMap<Interval, T2, Policy2, Storage2> &other,
+                     typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator otherIter) const {
         return findFirstOverlapImpl(*this, thisIter, other, otherIter);
     }
 
-    template<class IMap, typename T2, class Policy2>
+    template<class IMap, typename T2, class Policy2, class Storage2>
     static std::pair<typename IntervalMapTraits<IMap>::NodeIterator,
-                     typename IntervalMap<Interval, T2, Policy2>::ConstNodeIterator>
+                     typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator>
     findFirstOverlapImpl(IMap &imap,
                          typename IntervalMapTraits<IMap>::NodeIterator thisIter,
-                         const IntervalMap<Interval, T2, Policy2> &other,
-                         typename IntervalMap<Interval, T2, Policy2>::ConstNodeIterator otherIter) {
+                         const IntervalMap<Interval, T2, Policy2, Storage2> &other,
+                         typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator otherIter) {
         while (thisIter!=imap.nodes().end() && otherIter!=other.nodes().end()) {
             if (thisIter->key().isOverlapping(otherIter->key()))
                 return std::make_pair(thisIter, otherIter);
@@ -823,10 +871,10 @@ public:
     /** Erase intervals specified in another IntervalMap
      *
      *  Every interval in @p other is erased from this container. */
-    template<typename T2, class Policy2>
-    void eraseMultiple(const IntervalMap<Interval, T2, Policy2> &other) {
+    template<typename T2, class Policy2, class Storage2>
+    void eraseMultiple(const IntervalMap<Interval, T2, Policy2, Storage2> &other) {
         ASSERT_forbid2((const void*)&other == (const void*)this, "use clear() instead");
-        typedef typename IntervalMap<Interval, T2, Policy2>::ConstNodeIterator OtherIter;
+        typedef typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator OtherIter;
         for (OtherIter oi=other.nodes().begin(); oi!=other.nodes().end(); ++oi)
             erase(oi->key());
     }
@@ -879,10 +927,10 @@ public:
      *
      *  The values in the other container must be convertable to values of this container, and the intervals must be the same
      *  type. */
-    template<typename T2, class Policy2>
-    void insertMultiple(const IntervalMap<Interval, T2, Policy2> &other, bool makeHole=true) {
+    template<typename T2, class Policy2, class Storage2>
+    void insertMultiple(const IntervalMap<Interval, T2, Policy2, Storage2> &other, bool makeHole=true) {
         ASSERT_forbid2((const void*)&other == (const void*)this, "cannot insert a container into itself");
-        typedef typename IntervalMap<Interval, T2, Policy>::ConstNodeIterator OtherIter;
+        typedef typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator OtherIter;
         for (OtherIter oi=other.nodes().begin(); oi!=other.nodes().end(); ++oi)
             insert(oi->key(), Value(oi->value()), makeHole);
     }
@@ -901,8 +949,8 @@ public:
         return findFirstOverlap(interval)!=nodes().end();
     }
 
-    template<typename T2, class Policy2>
-    bool isOverlapping(const IntervalMap<Interval, T2, Policy2> &other) const {
+    template<typename T2, class Policy2, class Storage2>
+    bool isOverlapping(const IntervalMap<Interval, T2, Policy2, Storage2> &other) const {
         return findFirstOverlap(nodes().begin(), other, other.nodes().begin()).first != nodes().end();
     }
 
@@ -910,8 +958,8 @@ public:
         return !isOverlapping(interval);
     }
 
-    template<typename T2, class Policy2>
-    bool isDistinct(const IntervalMap<Interval, T2, Policy2> &other) const {
+    template<typename T2, class Policy2, class Storage2>
+    bool isDistinct(const IntervalMap<Interval, T2, Policy2, Storage2> &other) const {
         return !isOverlapping(other);
     }
 
@@ -932,9 +980,10 @@ public:
         }
     }
 
-    template<typename T2, class Policy2>
-    bool contains(const IntervalMap<Interval, T2, Policy2> &other) const {
-        for (ConstNodeIterator iter=other.nodes().begin(); iter!=other.nodes().end(); ++iter) {
+    template<typename T2, class Policy2, class Storage2>
+    bool contains(const IntervalMap<Interval, T2, Policy2, Storage2> &other) const {
+        typedef typename IntervalMap<Interval, T2, Policy2, Storage2>::ConstNodeIterator OtherIter;
+        for (OtherIter iter=other.nodes().begin(); iter!=other.nodes().end(); ++iter) {
             if (!contains(iter->key()))
                 return false;
         }
@@ -50,14 +50,16 @@ namespace Container {
  *  bool isInsnsDisjoint = functionExtent.size() == insnTotalSize;
  * @endcode
  *
- *  The @p Interval template parameter must implement the Sawyer::Container::Interval API, at least to some extent. */
-template<class I>
+ *  The @p Interval template parameter must implement the Sawyer::Container::Interval API, at least to some extent. The
+ *  optional @p Storage parameter selects how the intervals are stored; see @ref IntervalMap. */
+template<class I, class Storage = MapStorage>
 class IntervalSet {
     // We use an IntervalMap to do all our work, always storing int(0) as the value.
-    typedef IntervalMap<I, int> Map;
+    typedef IntervalMap<I, int, MergePolicy<I, int>, Storage> Map;
     Map map_;
 
 private:
+    template<class I2, class Storage2> friend class IntervalSet;
     friend class boost::serialization::access;
 
     template<class S>
@@ -75,7 +77,7 @@ public:
      *  parameter. Dereferencing the iterator will return a const reference to an interval (possibly a singlton interval). */
     class ConstIntervalIterator: public boost::iterator_facade<ConstIntervalIterator, const Interval,
                                                                boost::bidirectional_traversal_tag> {
-        typedef typename IntervalMap<Interval, int>::ConstNodeIterator MapNodeIterator;
+        typedef typename IntervalMap<Interval, int, MergePolicy<Interval, int>, Storage>::ConstNodeIterator MapNodeIterator;
         MapNodeIterator iter_;
     public:
         ConstIntervalIterator() {}
@@ -149,9 +151,9 @@ public:
     /** Copy constructor.
      *
      *  The newly constructed set will contain copies of the nodes from @p other. */
-    template<class Interval2>
-    IntervalSet(const IntervalSet<Interval2> &other) {
-        typedef typename IntervalSet<Interval2>::ConstIntervalIterator OtherIntervalIterator;
+    template<class Interval2, class Storage2>
+    IntervalSet(const IntervalSet<Interval2, Storage2> &other) {
+        typedef typename IntervalSet<Interval2, Storage2>::ConstIntervalIterator OtherIntervalIterator;
         for (OtherIntervalIterator otherIter=other.intervals().begin(); otherIter!=other.intervals().end(); ++otherIter)
             insert(*otherIter);
     }
@@ -160,9 +162,9 @@ public:
      *
      *  The newly constructed set will contain copies of the intervals from the specified @ref IntervalMap.  The map's
      *  intervals must be convertible to the set's interval type. The map's values are not used. */
-    template<class Interval2, class T, class Policy>
-    explicit IntervalSet(const IntervalMap<Interval2, T, Policy> &other) {
-        typedef typename IntervalMap<Interval2, T, Policy>::ConstNodeIterator OtherNodeIterator;
+    template<class Interval2, class T, class Policy, class Storage2>
+    explicit IntervalSet(const IntervalMap<Interval2, T, Policy, Storage2> &other) {
+        typedef typename IntervalMap<Interval2, T, Policy, Storage2>::ConstNodeIterator OtherNodeIterator;
         for (OtherNodeIterator otherIter=other.nodes().begin(); otherIter!=other.nodes().end(); ++otherIter)
             insert(otherIter->key());
     }
@@ -181,10 +183,10 @@ public:
      *
      *  Causes this set to contain the same intervals as the @p other set. The other set's intervals must be convertible to
      *  this set's interval type. */
-    template<class Interval2>
-    IntervalSet& operator=(const IntervalSet<Interval2> &other) {
+    template<class Interval2, class Storage2>
+    IntervalSet& operator=(const IntervalSet<Interval2, Storage2> &other) {
         clear();
-        typedef typename IntervalSet<Interval2>::ConstIntervalIterator OtherIntervalIterator;
+        typedef typename IntervalSet<Interval2, Storage2>::ConstIntervalIterator OtherIntervalIterator;
         for (OtherIntervalIterator otherIter=other.intervals().begin(); otherIter!=other.intervals().end(); ++otherIter)
             insert(*otherIter);
         return *this;
@@ -196,10 +198,10 @@ public:
      *  set's interval type.  Since sets and maps have different requirements regarding merging of neighboring intervals, the
      *  returned container might not have node-to-node correspondence with the map, but both will contain the same logical
      *  intervals. */
-    template<class Interval2, class T, class Policy>
-    IntervalSet& operator=(const IntervalMap<Interval2, T, Policy> &other) {
+    template<class Interval2, class T, class Policy, class Storage2>
+    IntervalSet& operator=(const IntervalMap<Interval2, T, Policy, Storage2> &other) {
         clear();
-        typedef typename IntervalMap<Interval2, T, Policy>::ConstNodeIterator OtherNodeIterator;
+        typedef typename IntervalMap<Interval2, T, Policy, Storage2>::ConstNodeIterator OtherNodeIterator;
         for (OtherNodeIterator otherIter=other.nodes().begin(); otherIter!=other.nodes().end(); ++otherIter)
             insert(otherIter->key());
         return *this;
@@ -336,13 +338,13 @@ public:
         return map_.isOverlapping(interval);
     }
 
-    template<class Interval2>
-    bool isOverlapping(const IntervalSet<Interval2> &other) const {
+    template<class Interval2, class Storage2>
+    bool isOverlapping(const IntervalSet<Interval2, Storage2> &other) const {
         return map_.isOverlapping(other.map_);
     }
 
-    template<class Interval2, class T2, class Policy2>
-    bool isOverlapping(const IntervalMap<Interval2, T2, Policy2> &other) const {
+    template<class Interval2, class T2, class Policy2, class Storage2>
+    bool isOverlapping(const IntervalMap<Interval2, T2, Policy2, Storage2> &other) const {
         return map_.isOverlapping(other);
     }
     /** @} */
@@ -357,13 +359,13 @@ public:
         return !isOverlapping();
     }
 
-    template<class Interval2>
-    bool isDistinct(const IntervalSet<Interval2> &other) const {
+    template<class Interval2, class Storage2>
+    bool isDistinct(const IntervalSet<Interval2, Storage2> &other) const {
         return !isOverlapping(other);
     }
 
-    template<class Interval2, class T2, class Policy2>
-    bool isDistinct(const IntervalMap<Interval2, T2, Policy2> &other) const {
+    template<class Interval2, class T2, class Policy2, class Storage2>
+    bool isDistinct(const IntervalMap<Interval2, T2, Policy2, Storage2> &other) const {
         return !isOverlapping(other);
     }
     /** @} */
@@ -389,13 +391,13 @@ public:
         return map_.contains(interval);
     }
 
-    template<class Interval2>
-    bool contains(const IntervalSet<Interval2> &other) const {
+    template<class Interval2, class Storage2>
+    bool contains(const IntervalSet<Interval2, Storage2> &other) const {
         return map_.contains(other.map_);
     }
 
-    template<class Interval2, class T2, class Policy2>
-    bool contains(const IntervalMap<Interval2, T2, Policy2> &other) const {
+    template<class Interval2, class T2, class Policy2, class Storage2>
+    bool contains(const IntervalMap<Interval2, T2, Policy2, Storage2> &other) const {
         return map_.contains(other);
     }
     /** @} */
@@ -533,16 +535,16 @@ public:
         map_.insert(interval, 0);
     }
 
-    template<class Interval2>
-    void insertMultiple(const IntervalSet<Interval2> &other) {
-        typedef typename IntervalSet<Interval2>::ConstIntervalIterator OtherIterator;
+    template<class Interval2, class Storage2>
+    void insertMultiple(const IntervalSet<Interval2, Storage2> &other) {
+        typedef typename IntervalSet<Interval2, Storage2>::ConstIntervalIterator OtherIterator;
         for (OtherIterator otherIter=other.intervals().begin(); otherIter!=other.intervals().end(); ++otherIter)
             map_.insert(*otherIter, 0);
     }
 
-    template<class Interval2, class T, class Policy>
-    void insertMultiple(const IntervalMap<Interval2, T, Policy> &other) {
-        typedef typename IntervalMap<Interval2, T, Policy>::ConstIntervalIterator OtherIterator;
+    template<class Interval2, class T, class Policy, class Storage2>
+    void insertMultiple(const IntervalMap<Interval2, T, Policy, Storage2> &other) {
+        typedef typename IntervalMap<Interval2, T, Policy, Storage2>::ConstIntervalIterator OtherIterator;
         for (OtherIterator otherIter=other.intervals().begin(); otherIter!=other.intervals().end(); ++otherIter)
             map_.insert(*otherIter, 0);
     }
@@ -559,17 +561,17 @@ public:
         map_.erase(interval);
     }
 
-    template<class Interval2>
-    void eraseMultiple(const IntervalSet<Interval2> &other) {
+    template<class Interval2, class Storage2>
+    void eraseMultiple(const IntervalSet<Interval2, Storage2> &other) {
         ASSERT_forbid2((void*)&other==(void*)this, "use IntervalSet::clear() instead");
-        typedef typename IntervalSet<Interval2>::ConstIntervalIterator OtherIntervalIterator;
+        typedef typename IntervalSet<Interval2, Storage2>::ConstIntervalIterator OtherIntervalIterator;
         for (OtherIntervalIterator otherIter=other.intervals().begin(); otherIter!=other.intervals().end(); ++otherIter)
             map_.erase(*otherIter);
     }
 
-    template<class Interval2, class T, class Policy>
-    void eraseMultiple(const IntervalMap<Interval2, T, Policy> &other) {
-        typedef typename IntervalMap<Interval2, T, Policy>::ConstIntervalIterator OtherIntervalIterator;
+    template<class Interval2, class T, class Policy, class Storage2>
+    void eraseMultiple(const IntervalMap<Interval2, T, Policy, Storage2> &other) {
+        typedef typename IntervalMap<Interval2, T, Policy, Storage2>::ConstIntervalIterator OtherIntervalIterator;
         for (OtherIntervalIterator otherIter=other.intervals().begin(); otherIter!=other.intervals().end(); ++otherIter)
             map_.erase(otherIter->first);
     }
@@ -596,14 +598,14 @@ public:
             map_.erase(Interval::hull(interval.greatest(), hull().greatest()));
     }
 
-    template<class Interval2>
-    void intersect(IntervalSet<Interval2> other) {
+    template<class Interval2, class Storage2>
+    void intersect(IntervalSet<Interval2, Storage2> other) {
         other.invert(hull());
         map_.eraseMultiple(other.map_);
     }
 
-    template<class Interval2, class T, class Policy>
-    void intersect(const IntervalMap<Interval2, T, Policy> &other);// FIXME[Robb Matzke 2014-04-12]: not implemented yet
+    template<class Interval2, class T, class Policy, class Storage2>
+    void intersect(const IntervalMap<Interval2, T, Policy, Storage2> &other);// FIXME[Robb Matzke 2014-04-12]: not implemented yet
     /** @} */
 
 
@@ -12,6 +12,8 @@
 #include <boost/foreach.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstring>
 #include <list>
 #include <Sawyer/Assert.h>
 #include <Sawyer/Interval.h>
@@ -55,7 +57,16 @@ namespace Sawyer {
  *
  *  Deleting a pool allocator deletes all its pools, which deletes all the chunks, which deallocates memory that might be in
  *  use by objects allocated from this allocator.  In other words, don't destroy the allocator unless you're willing that the
- *  memory for any objects in use will suddenly be freed without even calling the destructors for those objects. */
+ *  memory for any objects in use will suddenly be freed without even calling the destructors for those objects.
+ *
+ *  A multi-threaded pool gives each thread its own small cache of free cells for each pool, called a magazine.  Allocation
+ *  and deallocation normally use only the calling thread's magazine and take no locks. When a magazine becomes empty it is
+ *  refilled with @ref MAGAZINE_SIZE cells from the pool's shared free lists, and when it becomes too full half of it is
+ *  returned to the shared free lists, so the shared (locked) free lists are touched only once per @ref MAGAZINE_SIZE
+ *  operations.  Cells in a magazine are not available to other threads until they're flushed back to the pool, which happens
+ *  automatically when the thread exits (or explicitly with @ref flushMagazines).
+ *
+ *  Allocation statistics for each pool are available from the @ref statistics method. */
 template<size_t smallestCell, size_t sizeDelta, size_t nPools, size_t chunkSize, typename Sync>
 class PoolAllocatorBase {
 public:
@@ -64,12 +75,65 @@ public:
     enum { N_POOLS = nPools };
     enum { CHUNK_SIZE = chunkSize };
     enum { N_FREE_LISTS = 32 };                          // number of free lists per pool
+    enum { MAGAZINE_SIZE = 64 };                         /**< Number of cells moved between a thread and a pool at once. */
+
+    /** Whether per-thread magazines are used.
+     *
+     *  Magazines are used only for multi-threaded allocators when Sawyer is compiled with thread support. */
+    enum { USE_MAGAZINES = SynchronizationTraits<Sync>::SUPPORTED };
+
+    /** Statistics for one pool.
+     *
+     *  Counts of cells are approximate when other threads are concurrently using the allocator. */
+    struct Statistics {
+        size_t cellSize;                                /**< Size of each cell in bytes. */
+        size_t nChunks;                                 /**< Number of chunks allocated from the system. */
+        size_t nReserved;                               /**< Number of cells in all chunks. */
+        size_t nLive;                                   /**< Number of cells currently allocated to callers. */
+        size_t nCached;                                 /**< Number of free cells held in per-thread magazines. */
+        size_t nPeak;                                   /**< Largest value of nLive+nCached seen so far. */
+        size_t nExchanges;                              /**< Number of times the shared free lists were accessed. */
+        size_t nContended;                              /**< Number of shared free list accesses that had to wait for a lock. */
+        Statistics()
+            : cellSize(0), nChunks(0), nReserved(0), nLive(0), nCached(0), nPeak(0), nExchanges(0), nContended(0) {}
+    };
 
 private:
+    typedef typename SynchronizationTraits<Sync>::Mutex Mutex;
+    typedef typename SynchronizationTraits<Sync>::LockGuard LockGuard;
 
     // Singly-linked list of cells (units of object backing store) that are not being used by the caller.
     struct FreeCell { FreeCell *next; };
 
+    // A thread's private list of free cells for one pool.
+    struct Magazine {
+        FreeCell *cells;
+        size_t nCells;
+        Magazine(): cells(NULL), nCells(0) {}
+    };
+
+    // All magazines for one thread.  A rack is used without locking by the thread that owns it; other threads only read the
+    // counts for the sake of statistics.
+    struct Rack {
+        Magazine magazines[nPools];
+    };
+
+    // Each thread has a small cache of the racks it most recently used, keyed by allocator serial number.  Serial numbers are
+    // never reused, so entries for destroyed allocators are simply never matched again. Thread-local storage is limited to
+    // POD types, so this is allocated on first use and retired when the thread exits, at which time the thread's racks are
+    // flushed and removed from their allocators. The list of owned racks is protected by bigMutex since allocator destructors
+    // remove their racks from it.
+    enum { N_CACHED_RACKS = 4 };
+    struct ThreadRacks {
+        size_t serials[N_CACHED_RACKS];
+        Rack *racks[N_CACHED_RACKS];
+        std::vector<std::pair<PoolAllocatorBase*, Rack*> > owned;
+        ThreadRacks() {
+            memset(serials, 0, sizeof serials);
+            memset(racks, 0, sizeof racks);
+        }
+    };
+
     typedef Sawyer::Container::Interval<boost::uint64_t> ChunkAddressInterval;
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -118,12 +182,27 @@ private:
 
     class Pool;
 
+    // Aquire a lock, counting whether some other thread held it.  The counter is incremented while the lock is held.
+    class CountingLockGuard {
+        Mutex &mutex_;
+    public:
+        CountingLockGuard(Mutex &mutex, size_t &nContended): mutex_(mutex) {
+            if (!mutex_.try_lock()) {
+                mutex_.lock();
+                ++nContended;
+            }
+        }
+        ~CountingLockGuard() {
+            mutex_.unlock();
+        }
+    };
+
     // Aquire all locks for a pool.
     class LockEverything {
-        SAWYER_THREAD_TRAITS::Mutex *freeListMutexes_, &chunkMutex_;
+        Mutex *freeListMutexes_, &chunkMutex_;
         size_t nLocked_;
     public:
-        LockEverything(SAWYER_THREAD_TRAITS::Mutex *freeListMutexes, SAWYER_THREAD_TRAITS::Mutex &chunkMutex)
+        LockEverything(Mutex *freeListMutexes, Mutex &chunkMutex)
             : freeListMutexes_(freeListMutexes), chunkMutex_(chunkMutex), nLocked_(0) {
             while (nLocked_ < N_FREE_LISTS) {
                 freeListMutexes_[nLocked_].lock();
@@ -151,20 +230,29 @@ private:
         // free-list uniformly at random in order to keep the sizes of the free-lists relatively equal. There is no requirement
         // that an object allocated from one free-list be released back to the same free-list. Each free-list has its own
         // mutex. When locking multiple free-lists, the locks should be aquired in order of their indexes.
-        SAWYER_THREAD_TRAITS::Mutex freeListMutexes_[N_FREE_LISTS];
+        Mutex freeListMutexes_[N_FREE_LISTS];
         FreeCell *freeLists_[N_FREE_LISTS];
+        size_t nContended_[N_FREE_LISTS];               // times the free-list lock was contended; protected by that lock
+        size_t nExchanges_[N_FREE_LISTS];               // times the free-list was accessed; protected by that lock
 
         // The chunk-list stores the memory allocated for objects.  The chunk-list is protected by a mutex. When locking
         // free-list(s) and the chunk-list, the free-list locks should be aquired first.
-        mutable SAWYER_THREAD_TRAITS::Mutex chunkMutex_;
+        mutable Mutex chunkMutex_;
         std::list<Chunk*> chunks_;
 
+        // Number of cells that are not on any shared free list (i.e., allocated to callers or held in magazines), and the
+        // largest such number. Protected by their own mutex, which is never held while aquiring another lock.
+        mutable Mutex countMutex_;
+        size_t nOut_, nPeak_;
+
     private:
         Pool(const Pool&);                              // nonsense
 
     public:
-        Pool(): cellSize_(0) {
+        Pool(): cellSize_(0), nOut_(0), nPeak_(0) {
             memset(freeLists_, 0, sizeof freeLists_);
+            memset(nContended_, 0, sizeof nContended_);
+            memset(nExchanges_, 0, sizeof nExchanges_);
         }
 
         void init(size_t cellSize) {
@@ -180,35 +268,84 @@ private:
         }
 
         bool isEmpty() const {
-            SAWYER_THREAD_TRAITS::LockGuard lock(chunkMutex_);
+            LockGuard lock(chunkMutex_);
             return chunks_.empty();
         }
 
         // Obtains the cell at the front of the free list, allocating more space if necessary.
         void* aquire() {                                // hot
-            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
-            SAWYER_THREAD_TRAITS::LockGuard lock(freeListMutexes_[freeListIdx]);
-            if (!freeLists_[freeListIdx]) {
-                Chunk *chunk = new Chunk;
-                freeLists_[freeListIdx] = chunk->fill(cellSize_);
-                SAWYER_THREAD_TRAITS::LockGuard lock(chunkMutex_);
-                chunks_.push_back(chunk);
-            }
-            ASSERT_not_null(freeLists_[freeListIdx]);
-            FreeCell *cell = freeLists_[freeListIdx];
-            freeLists_[freeListIdx] = freeLists_[freeListIdx]->next;
+            Magazine magazine;
+            aquireMultiple(magazine, 1);
+            FreeCell *cell = magazine.cells;
             cell->next = NULL;                          // optional
             return cell;
         }
 
         // Returns an cell to the front of the free list.
         void release(void *cell) {                      // hot
-            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
-            SAWYER_THREAD_TRAITS::LockGuard lock(freeListMutexes_[freeListIdx]);
             ASSERT_not_null(cell);
             FreeCell *freedCell = reinterpret_cast<FreeCell*>(cell);
-            freedCell->next = freeLists_[freeListIdx];
-            freeLists_[freeListIdx] = freedCell;
+            freedCell->next = NULL;
+            releaseMultiple(freedCell, freedCell, 1);
+        }
+
+        // Moves up to n cells from the front of one shared free list to the front of the magazine, allocating more space if
+        // necessary.  At least one cell is always moved.
+        void aquireMultiple(Magazine &magazine, size_t n) {
+            ASSERT_require(n > 0);
+            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
+            size_t nMoved = 1;
+            {
+                CountingLockGuard lock(freeListMutexes_[freeListIdx], nContended_[freeListIdx]);
+                ++nExchanges_[freeListIdx];
+                if (!freeLists_[freeListIdx]) {
+                    Chunk *chunk = new Chunk;
+                    freeLists_[freeListIdx] = chunk->fill(cellSize_);
+                    LockGuard lock(chunkMutex_);
+                    chunks_.push_back(chunk);
+                }
+                ASSERT_not_null(freeLists_[freeListIdx]);
+                FreeCell *first = freeLists_[freeListIdx], *last = first;
+                while (nMoved < n && last->next) {
+                    last = last->next;
+                    ++nMoved;
+                }
+                freeLists_[freeListIdx] = last->next;
+                last->next = magazine.cells;
+                magazine.cells = first;
+                magazine.nCells += nMoved;
+            }
+            LockGuard lock(countMutex_);
+            nOut_ += nMoved;
+            nPeak_ = std::max(nPeak_, nOut_);
+        }
+
+        // Moves a list of n cells (first through last, inclusive) to the front of one shared free list.
+        void releaseMultiple(FreeCell *first, FreeCell *last, size_t n) {
+            ASSERT_not_null(first);
+            ASSERT_not_null(last);
+            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
+            {
+                CountingLockGuard lock(freeListMutexes_[freeListIdx], nContended_[freeListIdx]);
+                ++nExchanges_[freeListIdx];
+                last->next = freeLists_[freeListIdx];
+                freeLists_[freeListIdx] = first;
+            }
+            LockGuard lock(countMutex_);
+            ASSERT_require(nOut_ >= n);
+            nOut_ -= n;
+        }
+
+        // Returns the n cells at the front of the magazine to the shared free lists.
+        void releaseFromMagazine(Magazine &magazine, size_t n) {
+            ASSERT_require(n > 0);
+            ASSERT_require(n <= magazine.nCells);
+            FreeCell *first = magazine.cells, *last = first;
+            for (size_t i=1; i<n; ++i)
+                last = last->next;
+            magazine.cells = last->next;
+            magazine.nCells -= n;
+            releaseMultiple(first, last, n);
         }
 
         // Information about each chunk.
@@ -258,8 +395,9 @@ private:
                         freeListIdx = 0;
                 }
 
-                if (nNeeded < cellsPerChunk)
+                if (nNeeded <= cellsPerChunk)
                     return;
+                nNeeded -= cellsPerChunk;
             }
         }
         
@@ -309,7 +447,7 @@ private:
         size_t showInfo(std::ostream &out) const {
             ChunkInfoMap cim;
             {
-                LockEverything guard(const_cast<SAWYER_THREAD_TRAITS::Mutex*>(freeListMutexes_), chunkMutex_);
+                LockEverything guard(const_cast<Mutex*>(freeListMutexes_), chunkMutex_);
                 cim = chunkInfoNS();
             }
 
@@ -325,7 +463,7 @@ private:
         std::pair<size_t, size_t> nAllocated() const {
             ChunkInfoMap cim;
             {
-                LockEverything guard(const_cast<SAWYER_THREAD_TRAITS::Mutex*>(freeListMutexes_), chunkMutex_);
+                LockEverything guard(const_cast<Mutex*>(freeListMutexes_), chunkMutex_);
                 cim = chunkInfoNS();
             }
 
@@ -336,6 +474,26 @@ private:
                 nAllocated += info.nUsed;
             return std::make_pair(nAllocated, nReserved);
         }
+
+        // Statistics for this pool. The nCached member is filled in by the caller since it depends on the magazines.
+        Statistics statistics() const {
+            Statistics stats;
+            stats.cellSize = cellSize_;
+            {
+                LockGuard lock(chunkMutex_);
+                stats.nChunks = chunks_.size();
+            }
+            stats.nReserved = stats.nChunks * (chunkSize / cellSize_);
+            for (size_t freeListIdx = 0; freeListIdx < N_FREE_LISTS; ++freeListIdx) {
+                LockGuard lock(const_cast<Mutex&>(freeListMutexes_[freeListIdx]));
+                stats.nExchanges += nExchanges_[freeListIdx];
+                stats.nContended += nContended_[freeListIdx];
+            }
+            LockGuard lock(countMutex_);
+            stats.nLive = nOut_;
+            stats.nPeak = nPeak_;
+            return stats;
+        }
     };
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -343,12 +501,122 @@ private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 private:
     Pool *pools_;                                       // modified only in constructors and destructor
+    size_t serial_;                                     // unique non-zero allocator number for finding thread racks
+
+    // Racks for all threads that have used this allocator, keyed by the thread's ThreadRacks address.
+    mutable Mutex racksMutex_;
+    std::vector<std::pair<const ThreadRacks*, Rack*> > racks_;
 
     // Called only by constructors
     void init() {
         pools_ = new Pool[nPools];
         for (size_t i=0; i<nPools; ++i)
             pools_[i].init(cellSize(i));
+        SAWYER_THREAD_TRAITS::RecursiveLockGuard lock(bigMutex());
+        static size_t nextSerial = 0;
+        serial_ = ++nextSerial;
+    }
+
+    // The calling thread's rack cache.
+    static ThreadRacks*& threadRacksPointer() {         // hot
+        static SAWYER_THREAD_LOCAL ThreadRacks *threadRacks = NULL;
+        return threadRacks;
+    }
+
+    // The calling thread's rack for this allocator, created if necessary.
+    Rack* threadRack() {                                // hot
+        ThreadRacks *&threadRacks = threadRacksPointer();
+        if (!threadRacks)
+            threadRacks = newThreadRacks();
+        if (threadRacks->serials[0] == serial_)
+            return threadRacks->racks[0];
+        return threadRackSlow(threadRacks);
+    }
+
+    // Create the calling thread's rack cache and arrange for it to be retired when the thread exits. The thread-specific
+    // pointer is never destroyed since racks may still be needed during static destruction.
+    static ThreadRacks* newThreadRacks() {
+        ThreadRacks *threadRacks = new ThreadRacks;
+#if SAWYER_MULTI_THREADED
+        static boost::thread_specific_ptr<ThreadRacks> *retirement =
+            new boost::thread_specific_ptr<ThreadRacks>(retireThreadRacks);
+        retirement->reset(threadRacks);
+#endif
+        return threadRacks;
+    }
+
+    // Called when a thread exits. Returns the cells in all the thread's magazines to their pools and deletes its racks.
+    static void retireThreadRacks(ThreadRacks *threadRacks) {
+        if (threadRacksPointer() == threadRacks)
+            threadRacksPointer() = NULL;
+        SAWYER_THREAD_TRAITS::RecursiveLockGuard lock(bigMutex());
+        for (size_t i=0; i<threadRacks->owned.size(); ++i)
+            threadRacks->owned[i].first->retireRack(threadRacks, threadRacks->owned[i].second);
+        delete threadRacks;
+    }
+
+    // Flush a rack that belongs to an exiting thread and remove it from this allocator. The caller holds bigMutex.
+    void retireRack(const ThreadRacks *threadRacks, Rack *rack) {
+        for (size_t pn=0; pn<nPools; ++pn) {
+            if (rack->magazines[pn].nCells > 0)
+                pools_[pn].releaseFromMagazine(rack->magazines[pn], rack->magazines[pn].nCells);
+        }
+        {
+            LockGuard lock(racksMutex_);
+            for (size_t i=0; i<racks_.size(); ++i) {
+                if (racks_[i].first == threadRacks) {
+                    racks_.erase(racks_.begin() + i);
+                    break;
+                }
+            }
+        }
+        delete rack;
+    }
+
+    // Find the rack when it's not the calling thread's most recently used rack, and move it to the front of the thread's
+    // rack cache.
+    Rack* threadRackSlow(ThreadRacks *threadRacks) {
+        size_t idx = 1;
+        while (idx < N_CACHED_RACKS && threadRacks->serials[idx] != serial_)
+            ++idx;
+        Rack *rack = NULL;
+        if (idx < N_CACHED_RACKS) {
+            rack = threadRacks->racks[idx];
+        } else {
+            {
+                LockGuard lock(racksMutex_);
+                for (size_t i=0; i<racks_.size() && !rack; ++i) {
+                    if (racks_[i].first == threadRacks)
+                        rack = racks_[i].second;
+                }
+            }
+            if (!rack) {
+                // bigMutex must be aquired before racksMutex_
+                SAWYER_THREAD_TRAITS::RecursiveLockGuard bigLock(bigMutex());
+                rack = new Rack;
+                threadRacks->owned.push_back(std::make_pair(this, rack));
+                LockGuard lock(racksMutex_);
+                racks_.push_back(std::make_pair(threadRacks, rack));
+            }
+            idx = N_CACHED_RACKS - 1;                   // evict least recently used
+        }
+        for (/*void*/; idx > 0; --idx) {
+            threadRacks->serials[idx] = threadRacks->serials[idx-1];
+            threadRacks->racks[idx] = threadRacks->racks[idx-1];
+        }
+        threadRacks->serials[0] = serial_;
+        threadRacks->racks[0] = rack;
+        return rack;
+    }
+
+    // Number of cells held in all threads' magazines for one pool.  Magazine sizes are read without synchronization, so the
+    // result is approximate while other threads are using the allocator.
+    size_t nCached(size_t poolNumber) const {
+        size_t n = 0;
+        LockGuard lock(racksMutex_);
+        for (size_t i=0; i<racks_.size(); ++i)
+            n += racks_[i].second->magazines[poolNumber].nCells;
+        return n;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -378,6 +646,20 @@ public:
      *  Destroying a pool allocator destroys all its pools, which means that any objects that use storage managed by this pool
      *  will have their storage deleted. */
     virtual ~PoolAllocatorBase() {
+        if (USE_MAGAZINES) {
+            // Threads that are still running must not retire these racks when they exit.
+            SAWYER_THREAD_TRAITS::RecursiveLockGuard lock(bigMutex());
+            for (size_t i=0; i<racks_.size(); ++i) {
+                ThreadRacks *threadRacks = const_cast<ThreadRacks*>(racks_[i].first);
+                for (size_t j=0; j<threadRacks->owned.size(); ++j) {
+                    if (threadRacks->owned[j].first == this) {
+                        threadRacks->owned.erase(threadRacks->owned.begin() + j);
+                        break;
+                    }
+                }
+                delete racks_[i].second;
+            }
+        }
         delete[] pools_;
     }
 
@@ -422,7 +704,19 @@ public:
     void *allocate(size_t size) {                       // hot
         ASSERT_require(size>0);
         size_t pn = poolNumber(size);
-        return pn < nPools ? pools_[pn].aquire() : ::operator new(size);
+        if (pn >= nPools)
+            return ::operator new(size);
+        if (!USE_MAGAZINES)
+            return pools_[pn].aquire();
+
+        Magazine &magazine = threadRack()->magazines[pn];
+        if (0 == magazine.nCells)
+            pools_[pn].aquireMultiple(magazine, MAGAZINE_SIZE);
+        FreeCell *cell = magazine.cells;
+        magazine.cells = cell->next;
+        --magazine.nCells;
+        cell->next = NULL;                              // optional
+        return cell;
     }
 
     /** Reserve a certain number of objects in the pool.
@@ -434,7 +728,7 @@ public:
      *  should reserve slightly more than what will be needed. Reserving storage is entirely optional. */
     void reserve(size_t objectSize, size_t nObjects) {
         ASSERT_always_require(objectSize > 0); // so objectSize is always used
-        size_t pn = poolNumber(nObjects);
+        size_t pn = poolNumber(objectSize);
         if (pn >= nPools)
             return;
         pools_[pn].reserve(nObjects);
@@ -443,7 +737,8 @@ public:
     /** Number of objects allocated and reserved.
      *
      *  Returns a pair containing the number of objects currently allocated in the pool, and the number of objects that the
-     *  pool can hold (including those that are allocated) before the pool must request more memory from the system.
+     *  pool can hold (including those that are allocated) before the pool must request more memory from the system. Free
+     *  cells held in per-thread magazines are not counted as allocated.
      *
      *  Thread safety: This method is thread-safe. Of course, for a heavily contested pool the results are probably outdated by
      *  time they're returned to the caller */
@@ -451,11 +746,33 @@ public:
         size_t nAllocated = 0, nReserved = 0;
         for (size_t pn=0; pn<nPools; ++pn) {
             std::pair<size_t, size_t> pp = pools_[pn].nAllocated();
-            nAllocated += pp.first;
+            nAllocated += pp.first - std::min(pp.first, nCached(pn));
             nReserved += pp.second;
         }
         return std::make_pair(nAllocated, nReserved);
     }
+
+    /** Allocation statistics.
+     *
+     *  Returns statistics for each pool, indexed by pool number.  The @c nLive count for each pool is the number of cells
+     *  that are currently allocated to callers, @c nCached is the number of free cells held in per-thread magazines, and @c
+     *  nPeak is the largest value of their sum observed so far (an upper bound for the largest number of live cells).  The
+     *  @c nExchanges count is the number of times the pool's shared free lists were accessed, and @c nContended is how many of
+     *  those accesses found the lock already held by another thread.
+     *
+     *  Thread safety: This method is thread-safe, although results are approximate while other threads are using the
+     *  allocator. */
+    std::vector<Statistics> statistics() const {
+        std::vector<Statistics> retval;
+        retval.reserve(nPools);
+        for (size_t pn=0; pn<nPools; ++pn) {
+            Statistics stats = pools_[pn].statistics();
+            stats.nCached = std::min(stats.nLive, nCached(pn));
+            stats.nLive -= stats.nCached;
+            retval.push_back(stats);
+        }
+        return retval;
+    }
     
     /** Deallocate an object of specified size.
      *
@@ -470,29 +787,67 @@ public:
         if (addr) {
             ASSERT_require(size>0);
             size_t pn = poolNumber(size);
-            if (pn < nPools) {
+            if (pn >= nPools) {
+                ::operator delete(addr);
+            } else if (!USE_MAGAZINES) {
                 pools_[pn].release(addr);
             } else {
-                ::operator delete(addr);
+                Magazine &magazine = threadRack()->magazines[pn];
+                FreeCell *cell = reinterpret_cast<FreeCell*>(addr);
+                cell->next = magazine.cells;
+                magazine.cells = cell;
+                if (++magazine.nCells >= 2 * MAGAZINE_SIZE)
+                    pools_[pn].releaseFromMagazine(magazine, MAGAZINE_SIZE);
             }
         }
     }
 
+    /** Return the calling thread's cached cells to the pools.
+     *
+     *  Moves all free cells from the calling thread's magazines back to the shared free lists so they can be used by other
+     *  threads or released by @ref vacuum.  This happens automatically when a thread exits, so calling it is necessary only
+     *  when a long-running thread has stopped using this allocator.
+     *
+     *  Thread safety: This method is thread-safe. */
+    void flushMagazines() {
+        if (USE_MAGAZINES) {
+            Rack *rack = threadRack();
+            for (size_t pn=0; pn<nPools; ++pn) {
+                if (rack->magazines[pn].nCells > 0)
+                    pools_[pn].releaseFromMagazine(rack->magazines[pn], rack->magazines[pn].nCells);
+            }
+        }
+    }
+
+    /** Number of threads that have magazines.
+     *
+     *  Returns the number of threads that have used this allocator and not yet exited.  A thread's magazines are flushed and
+     *  removed when the thread exits.
+     *
+     *  Thread safety: This method is thread-safe. */
+    size_t nRacks() const {
+        LockGuard lock(racksMutex_);
+        return racks_.size();
+    }
+
     /** Delete unused chunks.
      *
      *  A pool allocator is optimized for the utmost performance when allocating and deallocating small objects, and therefore
      *  does minimal bookkeeping and does not free chunks.  This method traverses the free lists to discover which chunks have
-     *  no cells in use, removes those cells from the free list, and frees the chunk.
+     *  no cells in use, removes those cells from the free list, and frees the chunk.  Cells held in other threads' magazines
+     *  are considered to be in use; the calling thread's magazines are flushed first.
      *
      *  Thread safety: This method is thread-safe. */
     void vacuum() {
+        flushMagazines();
         for (size_t pn=0; pn<nPools; ++pn)
             pools_[pn].vacuum();
     }
 
     /** Print pool allocation information.
      *
-     *  Prints some interesting information about each chunk of each pool. The output will be multiple lines.
+     *  Prints some interesting information about each chunk of each pool. The output will be multiple lines.  Cells held in
+     *  per-thread magazines are reported as being in use.
      *
      *  Thread safety: This method is thread-safe. */
     void showInfo(std::ostream &out) const {
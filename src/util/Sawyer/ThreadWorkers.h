@@ -2,8 +2,8 @@
 //          be clobbered by the next update from Sawyer.  The Sawyer repository is at
 //          https://github.com/matzke1/sawyer.
 
-
-
+#ifndef Sawyer_ThreadWorkers_H
+#define Sawyer_ThreadWorkers_H
 
 #include <Sawyer/Exception.h>
 #include <Sawyer/Graph.h>
@@ -270,3 +270,5 @@ workInParallel(const DependencyGraph &dependencies, size_t nWorkers, Functor fun
 
 
 } // namespace
+
+#endif